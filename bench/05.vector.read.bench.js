@@ -0,0 +1,16 @@
+const b = require('benny')
+const { cases, save, nextTest, nextAsyncTest, toObjectTest, toJSONTest, toWKBTest } = require('./vector.common')
+
+module.exports = b.suite(
+  'Vector read',
+
+  ...cases(b, 'LayerFeatures.next()', nextTest),
+  ...cases(b, 'LayerFeatures.nextAsync()', nextAsyncTest),
+  ...cases(b, 'FeatureFields.toObject()', toObjectTest),
+  ...cases(b, 'Geometry.toJSON()', toJSONTest),
+  ...cases(b, 'Geometry.toWKB()', toWKBTest),
+
+  b.cycle(),
+  b.complete(),
+  save(b, 'vector.read')
+)
@@ -0,0 +1,13 @@
+const b = require('benny')
+const { cases, save, writeTest } = require('./vector.common')
+
+module.exports = b.suite(
+  'Vector write',
+
+  // Includes the Feature creation, the fields, the geometry and LayerFeatures.add()
+  ...cases(b, 'LayerFeatures.add()', writeTest),
+
+  b.cycle(),
+  b.complete(),
+  save(b, 'vector.write')
+)
@@ -0,0 +1,12 @@
+const b = require('benny')
+const { cases, save, executeSQLTest } = require('./vector.common')
+
+module.exports = b.suite(
+  'Vector SQL',
+
+  ...cases(b, 'Dataset.executeSQL()', executeSQLTest),
+
+  b.cycle(),
+  b.complete(),
+  save(b, 'vector.sql')
+)
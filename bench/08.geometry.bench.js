@@ -0,0 +1,13 @@
+const b = require('benny')
+const { cases, crossover, transformPointCases, save, tests } = require('./geometry.common')
+
+module.exports = b.suite(
+  'Geometry',
+
+  ...Object.keys(tests).reduce((a, name) => a.concat(cases(b, `Geometry.${name}()`, ...tests[name])), []),
+  ...transformPointCases(b),
+
+  b.cycle(),
+  b.complete(crossover),
+  save(b, 'geometry')
+)
@@ -0,0 +1,31 @@
+const b = require('benny')
+const assert = require('assert')
+const { gdal, save, options } = require('./geometry.common')
+
+// SpatialReference.fromEPSG() has no async version, fromUserInputAsync()
+// is the closest equivalent
+module.exports = b.suite(
+  'SpatialReference',
+
+  b.add('SpatialReference.fromEPSG() sync', () => {
+    assert(gdal.SpatialReference.fromEPSG(3857))
+  }, options),
+
+  b.add('SpatialReference.fromUserInput() sync', () => {
+    assert(gdal.SpatialReference.fromUserInput('EPSG:3857'))
+  }, options),
+
+  b.add('SpatialReference.fromUserInput() async', async () => {
+    assert(await gdal.SpatialReference.fromUserInputAsync('EPSG:3857'))
+  }, options),
+
+  b.add('new CoordinateTransformation() sync', () => {
+    const wgs84 = gdal.SpatialReference.fromEPSG(4326)
+    const webMercator = gdal.SpatialReference.fromEPSG(3857)
+    assert(new gdal.CoordinateTransformation(wgs84, webMercator))
+  }, options),
+
+  b.cycle(),
+  b.complete(),
+  save(b, 'srs')
+)
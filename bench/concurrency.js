@@ -0,0 +1,155 @@
+// Throughput and event loop latency of concurrent async operations
+// (see ASYNCIO.md)
+//
+// node bench/concurrency.js [threads=1,4,8,16] [datasets=1,4,16] [concurrency=16] [duration=3000]
+//
+// Every value of UV_THREADPOOL_SIZE is measured in a separate process as it cannot
+// be changed once the libuv thread pool has been started
+//
+// Each workload keeps <concurrency> operations in flight distributed over
+// <datasets> independently opened handles of the same file, so that
+// datasets=1 measures the lock contention and datasets=concurrency the parallelism
+const path = require('path')
+const fs = require('fs')
+const { spawnSync } = require('child_process')
+const { monitorEventLoopDelay } = require('perf_hooks')
+
+const args = Object.assign({
+  threads: '1,4,8,16',
+  datasets: '1,4,16',
+  concurrency: '16',
+  duration: '3000'
+}, Object.fromEntries(process.argv.slice(2).filter((a) => a.includes('=')).map((a) => a.split('='))))
+
+const list = (s) => s.split(',').map((v) => +v)
+
+const workloads = {
+  'pixels.readAsync()': {
+    setup: (gdal, datasets) => {
+      const file = path.resolve(__dirname, '..', 'test', 'data', 'sample.tif')
+      return Array.from({ length: datasets }, () => gdal.open(file).bands.get(1))
+    },
+    run: (gdal, band) => band.pixels.readAsync(0, 0, 984, 804)
+  },
+  'gdal.warpAsync()': {
+    setup: (gdal, datasets) => {
+      const file = path.resolve(__dirname, '..', 'test', 'data', 'sample.tif')
+      return Array.from({ length: datasets }, () => gdal.open(file))
+    },
+    run: (gdal, ds) => gdal.warpAsync('warp', null, [ ds ], [ '-of', 'MEM', '-t_srs', 'EPSG:3857', '-ts', '256', '256' ])
+  },
+  'features.nextAsync()': {
+    setup: (gdal, datasets) => {
+      const file = '/vsimem/bench_concurrency.geojson'
+      if (!gdal.fs.readDir('/vsimem').includes(path.basename(file))) {
+        const ds = gdal.drivers.get('GeoJSON').create(file)
+        const layer = ds.layers.create('bench', gdal.SpatialReference.fromEPSG(4326), gdal.wkbPoint)
+        layer.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+        for (let i = 0; i < 10000; i++) {
+          const feature = new gdal.Feature(layer)
+          feature.fields.set('id', i)
+          feature.setGeometry(new gdal.Point(i % 360 - 180, i % 180 - 90))
+          layer.features.add(feature)
+        }
+        ds.close()
+      }
+      return Array.from({ length: datasets }, () => gdal.open(file).layers.get(0))
+    },
+    run: async (gdal, layer) => {
+      if (!await layer.features.nextAsync()) await layer.features.firstAsync()
+    }
+  }
+}
+
+function percentiles(sorted) {
+  const at = (p) => sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))]
+  return { p50: at(0.5), p99: at(0.99), max: sorted[sorted.length - 1] }
+}
+
+async function measure(gdal, workload, datasets, concurrency, duration) {
+  const targets = workload.setup(gdal, datasets)
+  const latencies = []
+  const delay = monitorEventLoopDelay({ resolution: 1 })
+  const end = Date.now() + duration
+  let next = 0
+
+  const start = process.hrtime.bigint()
+  delay.enable()
+  await Promise.all(Array.from({ length: concurrency }, async () => {
+    while (Date.now() < end) {
+      const target = targets[next++ % targets.length]
+      const t0 = process.hrtime.bigint()
+      // eslint-disable-next-line no-await-in-loop
+      await workload.run(gdal, target)
+      latencies.push(Number(process.hrtime.bigint() - t0) / 1e6)
+    }
+  }))
+  delay.disable()
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e9
+
+  latencies.sort((a, b) => a - b)
+  const latency = percentiles(latencies)
+  return {
+    ops: latencies.length,
+    opsPerSec: +(latencies.length / elapsed).toFixed(1),
+    latencyP50: +latency.p50.toFixed(3),
+    latencyP99: +latency.p99.toFixed(3),
+    latencyMax: +latency.max.toFixed(3),
+    // The histogram is in nanoseconds
+    eventLoopDelayP50: +(delay.percentile(50) / 1e6).toFixed(3),
+    eventLoopDelayP99: +(delay.percentile(99) / 1e6).toFixed(3),
+    eventLoopDelayMax: +(delay.max / 1e6).toFixed(3)
+  }
+}
+
+async function child() {
+  const gdal = require('..')
+  // The sync calls in the setup are not a concern here
+  gdal.eventLoopWarning = false
+  const results = []
+  for (const name of Object.keys(workloads)) {
+    for (const datasets of list(args.datasets)) {
+      // eslint-disable-next-line no-await-in-loop
+      const r = await measure(gdal, workloads[name], datasets, +args.concurrency, +args.duration)
+      results.push(Object.assign({
+        workload: name,
+        threads: +process.env.UV_THREADPOOL_SIZE,
+        datasets,
+        concurrency: +args.concurrency
+      }, r))
+    }
+  }
+  process.stdout.write(JSON.stringify(results))
+}
+
+function parent() {
+  const results = []
+  for (const threads of list(args.threads)) {
+    console.log(`UV_THREADPOOL_SIZE=${threads}`)
+    const r = spawnSync(process.execPath, [ __filename, 'child=1', ...process.argv.slice(2) ], {
+      env: Object.assign({}, process.env, { UV_THREADPOOL_SIZE: threads }),
+      stdio: [ 'ignore', 'pipe', 'inherit' ],
+      maxBuffer: 64 * 1024 * 1024
+    })
+    if (r.status !== 0) throw new Error(`benchmark failed with UV_THREADPOOL_SIZE=${threads}`)
+    results.push(...JSON.parse(r.stdout.toString()))
+  }
+  console.table(results)
+
+  const folder = path.resolve(__dirname, 'results')
+  fs.mkdirSync(folder, { recursive: true })
+  fs.writeFileSync(path.resolve(folder, 'concurrency.json'), JSON.stringify({
+    version: require('../package.json').version,
+    date: new Date().toISOString(),
+    results
+  }, null, 2))
+}
+
+if (args.child) {
+  child().catch((e) => {
+    console.error(e)
+    process.exit(1)
+  })
+} else {
+  parent()
+}
@@ -0,0 +1,128 @@
+const assert = require('assert')
+
+const gdal = require('..')
+const { save } = require('./vector.common')
+
+// Every operation is measured in sync and async mode on geometries of every size
+// to find the size below which the thread-hop of the async version costs more than
+// the work itself
+const sizes = [ 10, 100, 1000, 10000, 100000, 1000000 ]
+
+const wgs84 = gdal.SpatialReference.fromEPSG(4326)
+const webMercator = gdal.SpatialReference.fromEPSG(3857)
+const transform = new gdal.CoordinateTransformation(wgs84, webMercator)
+
+// A circle of <size> vertices
+function ring(size, dx) {
+  const coordinates = []
+  for (let i = 0; i < size - 1; i++) {
+    const a = 2 * Math.PI * i / (size - 1)
+    coordinates.push([ dx + 10 * Math.cos(a), 10 * Math.sin(a) ])
+  }
+  coordinates.push(coordinates[0])
+  return coordinates
+}
+
+const fixtures = {}
+function fixture(size) {
+  if (!fixtures[size]) {
+    const geojson = { type: 'Polygon', coordinates: [ ring(size, 0) ] }
+    const geometry = gdal.Geometry.fromGeoJson(geojson)
+    geometry.srs = wgs84
+    const other = gdal.Geometry.fromGeoJson({ type: 'Polygon', coordinates: [ ring(size, 10) ] })
+    const points = geojson.coordinates[0].map(([ x, y ]) => ({ x, y }))
+    fixtures[size] = { geojson, geometry, other, points }
+  }
+  return fixtures[size]
+}
+
+// The smallest sizes run many more iterations than the largest ones
+const options = { minSamples: 5, maxTime: 2 }
+
+// Generate one sync and one async test case per size
+function cases(b, name, sync, async) {
+  const r = []
+  for (const size of sizes) {
+    r.push(b.add(`${name} sync ${size} vertices`, () => {
+      const f = fixture(size)
+      return () => sync(f)
+    }, options))
+    r.push(b.add(`${name} async ${size} vertices`, () => {
+      const f = fixture(size)
+      return async () => async(f)
+    }, options))
+  }
+  return r
+}
+
+// Print the async/sync throughput ratio of every operation for every size,
+// a ratio below 1 means that the operation is faster in sync mode
+function crossover(summary) {
+  const table = {}
+  for (const result of summary.results) {
+    const match = result.name.match(/^(.*) (sync|async) (\d+) vertices$/)
+    // the sync-only cases have no ratio
+    if (!match) continue
+    const [ , name, mode, size ] = match
+    table[name] = table[name] || {}
+    table[name][size] = table[name][size] || {}
+    table[name][size][mode] = result.ops
+  }
+  const ratios = {}
+  for (const name of Object.keys(table)) {
+    ratios[name] = {}
+    for (const size of Object.keys(table[name])) {
+      ratios[name][size] = +(table[name][size].async / table[name][size].sync).toFixed(2)
+    }
+  }
+  console.log('\nasync/sync throughput ratio (<1 means sync is faster)')
+  console.table(ratios)
+}
+
+const tests = {
+  fromGeoJson: [
+    (f) => assert(gdal.Geometry.fromGeoJson(f.geojson)),
+    async (f) => assert(await gdal.Geometry.fromGeoJsonAsync(f.geojson))
+  ],
+  toJSON: [
+    (f) => assert(f.geometry.toJSON().length > 0),
+    async (f) => assert((await f.geometry.toJSONAsync()).length > 0)
+  ],
+  transformTo: [
+    (f) => f.geometry.clone().transformTo(webMercator),
+    async (f) => f.geometry.clone().transformToAsync(webMercator)
+  ],
+  buffer: [
+    (f) => assert(f.geometry.buffer(1, 8)),
+    async (f) => assert(await f.geometry.bufferAsync(1, 8))
+  ],
+  intersection: [
+    (f) => assert(f.geometry.intersection(f.other)),
+    async (f) => assert(await f.geometry.intersectionAsync(f.other))
+  ],
+  transform: [
+    (f) => f.geometry.clone().transform(transform),
+    async (f) => f.geometry.clone().transformAsync(transform)
+  ]
+}
+
+// There is no transformPointAsync, transforming the same vertices one by one
+// is measured in sync mode only to compare it with Geometry.transform()
+function transformPointCases(b) {
+  return sizes.map((size) => b.add(`CoordinateTransformation.transformPoint() ${size} vertices`, () => {
+    const f = fixture(size)
+    return () => {
+      for (const p of f.points) transform.transformPoint(p)
+    }
+  }, options))
+}
+
+module.exports = {
+  gdal,
+  cases,
+  crossover,
+  transformPointCases,
+  save,
+  options,
+  tests
+}
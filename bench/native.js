@@ -0,0 +1,49 @@
+// Native micro-benchmarks of the internal primitives
+//
+// node bench/native.js [iterations=100000] [threads=1,2,4,8]
+//
+// These require a build with the micro-benchmarks enabled:
+// npm install --build-from-source --enable_micro_bench=true
+//
+// Benchmarks that use V8 run only on the main thread, all others are also run
+// concurrently to measure the contention on the ObjectStore locks
+const path = require('path')
+const fs = require('fs')
+const gdal = require('..')
+
+const args = Object.assign({
+  iterations: '100000',
+  threads: '1,2,4,8'
+}, Object.fromEntries(process.argv.slice(2).filter((a) => a.includes('=')).map((a) => a.split('='))))
+
+if (typeof gdal._microBench !== 'function') {
+  console.error('The native micro-benchmarks require gdal-async to be compiled with --enable_micro_bench=true')
+  process.exit(1)
+}
+
+const ds = gdal.open(path.resolve(__dirname, '..', 'test', 'data', 'sample.tif'))
+const results = []
+for (const name of gdal._microBench('', 0)) {
+  for (const threads of args.threads.split(',').map((v) => +v)) {
+    let ns
+    try {
+      ns = gdal._microBench(name, +args.iterations, threads, ds)
+    } catch (e) {
+      // Main thread only
+      if (threads > 1) continue
+      throw e
+    }
+    results.push({ name, threads, 'ns/op': +ns.toFixed(2), 'ops/sec': Math.round(1e9 / ns) })
+  }
+}
+ds.close()
+console.table(results)
+
+const folder = path.resolve(__dirname, 'results')
+fs.mkdirSync(folder, { recursive: true })
+fs.writeFileSync(path.resolve(folder, 'native.json'), JSON.stringify({
+  version: require('../package.json').version,
+  date: new Date().toISOString(),
+  gdal: gdal.version,
+  results
+}, null, 2))
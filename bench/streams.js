@@ -1,6 +1,8 @@
 const fs = require('fs')
 
-const bench = fs.readdirSync(__dirname).filter((file) => file.match(/\.bench\.js$/));
+// An optional argument selects the benchmarks by name, ie node bench/streams.js vector
+const filter = process.argv[2] ? new RegExp(process.argv[2]) : /./
+const bench = fs.readdirSync(__dirname).filter((file) => file.match(/\.bench\.js$/) && file.match(filter));
 
 (async () => {
   for (const b of bench) {
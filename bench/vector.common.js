@@ -0,0 +1,173 @@
+const path = require('path')
+const assert = require('assert')
+
+const gdal = require('..')
+
+// Every fixture is generated in /vsimem for every driver and every size
+const drivers = {
+  'GPKG': 'gpkg',
+  'GeoJSON': 'geojson',
+  'ESRI Shapefile': 'shp'
+}
+const sizes = [ 1000, 10000 ]
+
+const fixture = (driver, size) => `/vsimem/bench_vector_${size}.${drivers[driver]}`
+
+// A small square polygon with 8 vertices per side
+function polygon(i) {
+  const x = (i % 360) - 180
+  const y = (Math.floor(i / 360) % 180) - 90
+  const ring = []
+  for (let j = 0; j < 8; j++) ring.push([ x + j / 80, y ])
+  for (let j = 0; j < 8; j++) ring.push([ x + 0.1, y + j / 80 ])
+  for (let j = 0; j < 8; j++) ring.push([ x + 0.1 - j / 80, y + 0.1 ])
+  for (let j = 0; j < 8; j++) ring.push([ x, y + 0.1 - j / 80 ])
+  ring.push([ x, y ])
+  return gdal.Geometry.fromGeoJson({ type: 'Polygon', coordinates: [ ring ] })
+}
+
+function fillLayer(layer, size) {
+  layer.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+  layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+  layer.fields.add(new gdal.FieldDefn('value', gdal.OFTReal))
+  for (let i = 0; i < size; i++) {
+    const feature = new gdal.Feature(layer)
+    feature.fields.set({ id: i, name: `feature ${i}`, value: i / 2 })
+    feature.setGeometry(polygon(i))
+    layer.features.add(feature)
+  }
+}
+
+const initTest = (() => {
+  let initDone = false
+  return async function () {
+    // First test to execute does the initialization and creates
+    // a Promise for the other tests to await upon
+    // (because benny runs the initialization of all tests in parallel)
+    if (initDone) return initDone
+    let resolve, reject
+    initDone = new Promise((res, rej) => {
+      resolve = res
+      reject = rej
+    })
+
+    try {
+      for (const driver of Object.keys(drivers)) {
+        for (const size of sizes) {
+          const ds = gdal.drivers.get(driver).create(fixture(driver, size))
+          fillLayer(ds.layers.create('bench', gdal.SpatialReference.fromEPSG(4326), gdal.wkbPolygon), size)
+          ds.close()
+        }
+      }
+      resolve()
+    } catch (e) {
+      reject(e)
+    }
+  }
+})()
+
+// This is to signal benny that we have an asynchronous initialization part that is not to be measured
+// see (Async benchmark with setup - return a promise wrapped in a function) at <https://github.com/caderek/benny>
+const runTest = async (test, args) => {
+  await initTest()
+  return async () => test.apply(null, args)
+}
+
+// Generate one test case per driver and size
+function cases(b, name, test) {
+  const r = []
+  for (const driver of Object.keys(drivers)) {
+    for (const size of sizes) {
+      r.push(b.add(`${name} ${driver} ${size} features`, async () => runTest(test, [ driver, size ])))
+    }
+  }
+  return r
+}
+
+// Machine-readable results for comparing releases
+function save(b, file) {
+  return b.save({
+    file,
+    folder: path.resolve(__dirname, 'results'),
+    version: require('../package.json').version,
+    format: 'json'
+  })
+}
+
+async function nextTest(driver, size) {
+  const ds = gdal.open(fixture(driver, size))
+  const layer = ds.layers.get(0)
+  let count = 0
+  for (let f = layer.features.first(); f; f = layer.features.next()) count++
+  assert(count === size)
+  ds.close()
+}
+
+async function nextAsyncTest(driver, size) {
+  const ds = await gdal.openAsync(fixture(driver, size))
+  const layer = await ds.layers.getAsync(0)
+  let count = 0
+  for (let f = await layer.features.firstAsync(); f; f = await layer.features.nextAsync()) count++
+  assert(count === size)
+  ds.close()
+}
+
+async function toObjectTest(driver, size) {
+  const ds = gdal.open(fixture(driver, size))
+  const layer = ds.layers.get(0)
+  let sum = 0
+  for (let f = layer.features.first(); f; f = layer.features.next()) sum += f.fields.toObject().id
+  assert(sum === size * (size - 1) / 2)
+  ds.close()
+}
+
+async function toJSONTest(driver, size) {
+  const ds = gdal.open(fixture(driver, size))
+  const layer = ds.layers.get(0)
+  let length = 0
+  for (let f = layer.features.first(); f; f = layer.features.next()) length += f.getGeometry().toJSON().length
+  assert(length > 0)
+  ds.close()
+}
+
+async function toWKBTest(driver, size) {
+  const ds = gdal.open(fixture(driver, size))
+  const layer = ds.layers.get(0)
+  let length = 0
+  for (let f = layer.features.first(); f; f = layer.features.next()) length += f.getGeometry().toWKB().length
+  assert(length > 0)
+  ds.close()
+}
+
+async function writeTest(driver, size) {
+  const filename = `/vsimem/bench_vector_write.${String(Math.random()).substring(2)}.tmp.${drivers[driver]}`
+  const ds = gdal.drivers.get(driver).create(filename)
+  fillLayer(ds.layers.create('bench', gdal.SpatialReference.fromEPSG(4326), gdal.wkbPolygon), size)
+  ds.close()
+  for (const file of gdal.fs.readDir('/vsimem')) {
+    if (file.startsWith(path.basename(filename, `.${drivers[driver]}`))) gdal.vsimem.release(`/vsimem/${file}`)
+  }
+}
+
+async function executeSQLTest(driver, size) {
+  const ds = gdal.open(fixture(driver, size))
+  const table = ds.layers.get(0).name
+  const result = ds.executeSQL(`SELECT id, value FROM "${table}" WHERE value >= ${size / 4}`)
+  let count = 0
+  for (let f = result.features.first(); f; f = result.features.next()) count++
+  assert(count === size / 2)
+  // This also destroys the result set
+  ds.close()
+}
+
+module.exports = {
+  cases,
+  save,
+  nextTest,
+  nextAsyncTest,
+  toObjectTest,
+  toJSONTest,
+  toWKBTest,
+  writeTest,
+  executeSQLTest
+}
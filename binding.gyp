@@ -6,6 +6,7 @@
 		"shared_gdal%": "false",
 		"runtime_link%": "shared",
 		"enable_logging%": "false",
+		"enable_micro_bench%": "false",
 		"enable_asan%": "false",
 		"enable_coverage%": "false",
 		"sources_node_gdal": [
@@ -14,6 +15,9 @@
 				"src/utils/number_list.cpp",
 				"src/utils/warp_options.cpp",
 				"src/utils/ptr_manager.cpp",
+				"src/utils/logger.cpp",
+				"src/utils/trace.cpp",
+				"src/utils/io_stats.cpp",
 				"src/node_gdal.cpp",
 				"src/async.cpp",
 				"src/gdal_common.cpp",
@@ -49,6 +53,10 @@
 				"src/gdal_memfile.cpp",
 				"src/gdal_utils.cpp",
 				"src/gdal_fs.cpp",
+				"src/gdal_cache.cpp",
+				"src/gdal_vrt_builder.cpp",
+				"src/gdal_mosaic.cpp",
+				"src/gdal_raster_index.cpp",
 				"src/collections/dataset_bands.cpp",
 				"src/collections/dataset_layers.cpp",
 				"src/collections/layer_features.cpp",
@@ -126,6 +134,14 @@
 						"ENABLE_LOGGING=1"
 					]
 				}],
+				["enable_micro_bench != 'false'", {
+					"defines": [
+						"ENABLE_MICRO_BENCH=1"
+					],
+					"sources": [
+						"src/utils/micro_bench.cpp"
+					]
+				}],
 				["shared_gdal == 'false'", {
 					"defines": [
 						"BUNDLED_GDAL=1"
@@ -334,6 +334,7 @@
 					"./gdal/gcore",
 					"./gdal/port",
 					"./gdal/apps",
+					"./gdal/frmts/vrt",
 					"./gdal/ogr",
 					"./gdal/ogr/ogrsf_frmts"
 				],
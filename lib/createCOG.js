@@ -0,0 +1,131 @@
+const { Stream } = require('stream')
+
+/**
+ * @typedef {object} COGOptions
+ * @property {string} [compress] Compression method, `LZW` by default
+ * @property {number} [level] Compression level for `DEFLATE`, `ZSTD`, `LERC_DEFLATE`, `LERC_ZSTD` and `LZMA`
+ * @property {number} [quality] Quality for `JPEG` and `WEBP`
+ * @property {number} [blockSize] Tile size in pixels, `512` by default
+ * @property {string} [resampling] Resampling method of the overviews
+ * @property {string} [overviews] `AUTO` (default), `IGNORE_EXISTING`, `FORCE_USE_EXISTING` or `NONE`
+ * @property {number|string} [threads] Number of compression threads, `ALL_CPUS` by default
+ * @property {StringOptions} [creationOptions] Additional creation options of the COG driver
+ * @property {ProgressCb} [progress_cb]
+ */
+
+/**
+ * Convert a raster dataset to a Cloud-Optimized GeoTIFF.
+ *
+ * The conversion is performed by the GDAL COG driver in a single asynchronous
+ * operation: the tiles are compressed in parallel on `threads` threads and the
+ * file is written in the COG layout - ghost header, IFDs first and overviews
+ * before the full resolution data.
+ *
+ * The output can be a filename, including `/vsimem/`, or a Node.js `Writable`
+ * stream, in which case the file is produced in `/vsimem/` and then streamed -
+ * the whole COG is held in memory before the first byte is written to the stream
+ * as its header can be written only once the file is complete. On error,
+ * the stream is destroyed and the promise is rejected.
+ *
+ * There is no sync version
+ *
+ * @example
+ * await gdal.createCOGAsync(await gdal.openAsync('upload.tif'), '/vsimem/cog.tif',
+ *   { compress: 'DEFLATE', level: 6, resampling: 'AVERAGE' })
+ *
+ * // Directly into an HTTP response
+ * await gdal.createCOGAsync(ds, res, { compress: 'JPEG', quality: 85 })
+ *
+ * @function createCOGAsync
+ * @param {Dataset} src Source dataset
+ * @param {string|stream.Writable} dst Output filename or stream, including an `http.ServerResponse`
+ * @param {COGOptions} [options]
+ * @return {Promise<void>}
+ * @static
+ */
+const createCOG = (gdal) => async function createCOGAsync(src, dst, options) {
+  options = options || {}
+  if (!(src instanceof gdal.Dataset)) throw new TypeError('src must be an instance of gdal.Dataset')
+  // http.ServerResponse is a legacy Stream, not a stream.Writable
+  if (typeof dst !== 'string' && !(dst instanceof Stream && dst.writable)) {
+    throw new TypeError('dst must be a filename or a Writable stream')
+  }
+  if (options.progress_cb !== undefined && typeof options.progress_cb !== 'function') {
+    throw new TypeError('progress_cb must be a function')
+  }
+
+  let driver
+  try {
+    driver = gdal.drivers.get('COG')
+  } catch (e) {
+    throw new Error('The COG driver requires GDAL >= 3.1')
+  }
+
+  const creation = Object.assign({ NUM_THREADS: 'ALL_CPUS' }, options.creationOptions)
+  const map = {
+    compress: 'COMPRESS',
+    level: 'LEVEL',
+    quality: 'QUALITY',
+    blockSize: 'BLOCKSIZE',
+    resampling: 'RESAMPLING',
+    overviews: 'OVERVIEWS',
+    threads: 'NUM_THREADS'
+  }
+  for (const key of Object.keys(map)) {
+    if (options[key] !== undefined) creation[map[key]] = String(options[key])
+  }
+
+  const filename = typeof dst === 'string' ? dst :
+    `/vsimem/createCOG_${process.pid}_${Date.now()}_${Math.random().toString(36).slice(2)}.tif`
+
+  if (typeof dst === 'string') {
+    const cog = await driver.createCopyAsync(filename, src, creation, false,
+      options.progress_cb ? { progress_cb: options.progress_cb } : undefined)
+    cog.close()
+    return
+  }
+
+  try {
+    const cog = await driver.createCopyAsync(filename, src, creation, false,
+      options.progress_cb ? { progress_cb: options.progress_cb } : undefined)
+    cog.close()
+    await streamFile(gdal.vsimem.release(filename), dst)
+  } catch (e) {
+    // The error is reported by the promise
+    dst.on('error', () => undefined)
+    dst.destroy(e)
+    throw e
+  } finally {
+    try {
+      gdal.vsimem.release(filename)
+    } catch (e) {
+      // The file does not exist if the copy failed early or if it was already streamed
+    }
+  }
+}
+
+function streamFile(data, dst) {
+  const chunk = 1024 * 1024
+  return new Promise((resolve, reject) => {
+    let offset = 0
+    const onError = (e) => reject(e)
+    dst.once('error', onError)
+    const write = () => {
+      while (offset < data.length) {
+        const ok = dst.write(data.subarray(offset, offset + chunk))
+        offset += chunk
+        if (!ok) {
+          dst.once('drain', write)
+          return
+        }
+      }
+      dst.end(() => {
+        dst.removeListener('error', onError)
+        resolve()
+      })
+    }
+    write()
+  })
+}
+
+module.exports = createCOG
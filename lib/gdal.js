@@ -132,8 +132,10 @@ gdal.Geometry.prototype.getEnvelope3D = function () {
 
 const getEnvelopeAsync = gdal.Geometry.prototype.getEnvelopeAsync
 gdal.Geometry.prototype.getEnvelopeAsync = function () {
-  // arguments[arguments.length - 1] is the callback
   const old_cb = arguments[arguments.length - 1]
+  if (typeof old_cb !== 'function') {
+    return getEnvelopeAsync.apply(this, arguments).then((r) => new gdal.Envelope(r))
+  }
   const new_cb = (e, r) => {
     const obj = e ? undefined : new gdal.Envelope(r)
     old_cb(e, obj)
@@ -145,6 +147,9 @@ gdal.Geometry.prototype.getEnvelopeAsync = function () {
 const getEnvelope3DAsync = gdal.Geometry.prototype.getEnvelope3DAsync
 gdal.Geometry.prototype.getEnvelope3DAsync = function () {
   const old_cb = arguments[arguments.length - 1]
+  if (typeof old_cb !== 'function') {
+    return getEnvelope3DAsync.apply(this, arguments).then((r) => new gdal.Envelope3D(r))
+  }
   const new_cb = (e, r) => {
     const obj = e ? undefined : new gdal.Envelope3D(r)
     old_cb(e, obj)
@@ -159,6 +164,20 @@ gdal.Layer.prototype.getExtent = function () {
   return new gdal.Envelope(obj)
 }
 
+const getExtentAsync = gdal.Layer.prototype.getExtentAsync
+gdal.Layer.prototype.getExtentAsync = function () {
+  const old_cb = arguments[arguments.length - 1]
+  if (typeof old_cb !== 'function') {
+    return getExtentAsync.apply(this, arguments).then((r) => new gdal.Envelope(r))
+  }
+  const new_cb = (e, r) => {
+    const obj = e ? undefined : new gdal.Envelope(r)
+    old_cb(e, obj)
+  }
+  arguments[arguments.length - 1] = new_cb
+  getExtentAsync.apply(this, arguments)
+}
+
 const readStream = require('./readable.js')
 const writeStream = require('./writable.js')
 const muxStream = require('./multiplexer.js')
@@ -171,6 +190,10 @@ gdal.RasterTransform = muxStream.RasterTransform
 
 gdal.calcAsync = require('./calc')(gdal)
 
+gdal.createCOGAsync = require('./createCOG')(gdal)
+
+gdal.Dataset.prototype.queryAsync = require('./query')(gdal)
+
 gdal.wrapVRT = require('./wrapVRT')
 
 /**
@@ -353,7 +376,7 @@ require('./iterators.js')(gdal)
  * @method open
  * @static
  * @param {string|Buffer} path Path to dataset or in-memory Buffer to open
- * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`
+ * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`, add `"s"` to count the I/O operations (see `Dataset.ioStats()`)
  * @param {string|string[]} [drivers] Driver name, or list of driver names to attempt to use.
  *
  * @param {number} [x_size] Used when creating a raster dataset with the `"w"` mode.
@@ -431,7 +454,6 @@ gdal.open = (function () {
   }
 })()
 
-const promisify = require('util').promisify
 const callbackify = require('util').callbackify
 
 /**
@@ -453,7 +475,7 @@ const callbackify = require('util').callbackify
  * @method openAsync
  * @static
  * @param {string|Buffer} path Path to dataset or in-memory Buffer to open
- * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`
+ * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`, add `"s"` to count the I/O operations (see `Dataset.ioStats()`)
  * @param {string|string[]} [drivers] Driver name, or list of driver names to attempt to use.
  *
  * @param {number} [x_size] Used when creating a raster dataset with the `"w"` mode.
@@ -477,7 +499,8 @@ const callbackify = require('util').callbackify
 
 gdal.openAsync = (function () {
   const openPromise = (function () {
-    const openPromise = promisify(gdal.openAsync)
+    // The native gdal.openAsync returns a Promise when called without a callback
+    const openPromise = gdal.openAsync
 
     // add 'w' mode to gdal.open() method and also GDAL2-style driver selection
     return function (
@@ -734,7 +757,8 @@ const mangleRead = (args) => {
     options.line_space,
     options.resampling,
     options.progress_cb,
-    options.offset
+    options.offset,
+    options.withMask
   ]
 }
 
@@ -794,8 +818,8 @@ const GroupCollection = {
   getAsync: 1
 }
 
-// Generic promisifiable methods and the argument number of their callbacks
-const promisifiables = {
+// Generic async methods and the argument number of their callbacks
+const asyncables = {
   Driver: {
     createAsync: 6,
     createCopyAsync: 5,
@@ -804,22 +828,36 @@ const promisifiables = {
   Dataset: {
     flushAsync: 0,
     buildOverviewsAsync: 4,
+    adviseReadAsync: 5,
+    renderAsync: 2,
     executeSQLAsync: 3,
+    releaseResultSetAsync: 1,
     getMetadataAsync: 1,
-    setMetadataAsync: 2
+    setMetadataAsync: 2,
+    describeAsync: 1
   },
   Layer: {
-    flushAsync: 0
+    flushAsync: 0,
+    getExtentAsync: 1,
+    setAttributeFilterAsync: 1,
+    setSpatialFilterAsync: 4,
+    getSpatialFilterAsync: 0
   },
   RasterBand: {
     flushAsync: 0,
     fillAsync: 2,
     computeStatisticsAsync: 1,
     getMetadataAsync: 1,
-    setMetadataAsync: 2
+    setMetadataAsync: 2,
+    getCacheUsageAsync: 0,
+    getDataCoverageAsync: 4,
+    adviseReadAsync: 5
+  },
+  VRTBuilder: {
+    buildAsync: 0
   },
   RasterBandPixels: {
-    readAsync: 13,
+    readAsync: 14,
     writeAsync: 11,
     readBlockAsync: 3,
     writeBlockAsync: 3,
@@ -839,6 +877,7 @@ const promisifiables = {
     setAsync: 2,
     firstAsync: 0,
     nextAsync: 0,
+    nextBatchAsync: 2,
     addAsync: 1,
     countAsync: 1,
     removeAsync: 1
@@ -901,6 +940,12 @@ const promisifiables = {
     $fromCRSURLAsync: 1,
     $fromUserInputAsync: 1
   },
+  RasterIndex: {
+    saveAsync: 1,
+    $loadAsync: 1,
+    $fromFilesAsync: 2,
+    $fromLayerAsync: 2
+  },
   MDArray: {
     readAsync: 1
   },
@@ -929,6 +974,7 @@ const promisifiables = {
     $buildVRTAsync: 4,
     $rasterizeAsync: 4,
     $demAsync: 6,
+    $mosaicReadAsync: 3,
     $_acquireLocksAsync: 3
   }
 }
@@ -945,15 +991,17 @@ const argMangle = {
   }
 }
 
-// For each *Async function create a function that checks if the last parameter is a callback
-// Then call either the original, either the promisified version with the callback
-// placed at the right argument number since the C++ code does not support floating callbacks
-for (const c of Object.keys(promisifiables)) {
+// All async methods return a native Promise created in C++ when called without a callback
+// The callback, when present, must be at its fixed argument number since the C++ code
+// does not support floating callbacks
+// For each *Async function create a function that calls the native method directly
+// when the arguments are already in place and moves the callback otherwise
+for (const c of Object.keys(asyncables)) {
   const klass = c === '$' ? gdal : gdal[c]
   if (klass === undefined) {
     continue
   }
-  for (const _m of Object.keys(promisifiables[c])) {
+  for (const _m of Object.keys(asyncables[c])) {
     const { base, m } = _m.startsWith('$') ?
       { base: klass, m: _m.slice(1) } :
       { base: klass.prototype, m: _m }
@@ -961,23 +1009,24 @@ for (const c of Object.keys(promisifiables)) {
       continue
     }
     base[m] = (function () {
-      const promisified = promisify(base[m])
       const original = base[m]
-      const cbArg = promisifiables[c][_m]
-      const mangle = argMangle[c] && argMangle[c][_m] ? argMangle[c][_m] : (a) => a
+      const cbArg = asyncables[c][_m]
+      const mangle = argMangle[c] && argMangle[c][_m]
       return function () {
-        let callback
-        if (typeof arguments[arguments.length - 1] === 'function') {
-          callback = arguments[arguments.length - 1]
-          arguments[arguments.length - 1] = undefined
+        const last = arguments.length - 1
+        const callback = last >= 0 && typeof arguments[last] === 'function' ? arguments[last] : undefined
+        // Fast path, no copying of the arguments
+        if (!mangle && (callback ? last === cbArg : last < cbArg)) {
+          return original.apply(this, arguments)
+        }
+        if (callback) {
+          arguments[last] = undefined
         }
-        let args = Array.prototype.slice.call(mangle(arguments), 0, cbArg)
+        const args = Array.prototype.slice.call(mangle ? mangle(arguments) : arguments, 0, cbArg)
         if (callback) {
           args[cbArg] = callback
-          return original.apply(this, args)
         }
-        args = Object.assign(new Array(cbArg).fill(undefined), args)
-        return promisified.apply(this, args)
+        return original.apply(this, args)
       }
     })()
   }
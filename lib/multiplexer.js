@@ -13,6 +13,9 @@ const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_mux|g
  *
  * All the input streams must have the same length.
  *
+ * The input streams cannot be created with `skipEmpty` as
+ * their {@link RasterEmptyChunk} markers carry no pixels.
+ *
  * Can be used with {@link RasterTransform}
  * which will automatically apply a function over the whole chunk.
  *
@@ -70,6 +73,7 @@ class RasterMuxStream extends Readable {
       const inp = inputs[id]
       if (!(inp instanceof Readable)) throw new TypeError('inputs must be a map of Readables')
       if (!inp.readableObjectMode) throw new TypeError('All inputs must be in object mode')
+      if (inp.skipEmpty) throw new TypeError('Inputs created with skipEmpty are not supported')
 
       this.inputs[id] = inp
       this.buffers[id] = []
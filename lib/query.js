@@ -0,0 +1,96 @@
+/**
+ * @typedef {object} QueryOptions
+ * @property {string} [dialect] SQL dialect, `OGRSQL`, `SQLITE` or the native dialect of the driver by default
+ * @property {Geometry} [spatialFilter] Spatial filter applied to the query
+ * @property {number} [batchSize=1000] Number of features per batch
+ * @property {boolean} [columnar=false] Return one array per column instead of one object per feature
+ * @property {boolean} [geometry=true] Include the geometries
+ */
+
+/**
+ * Execute an SQL statement and iterate asynchronously over its results by batches.
+ *
+ * Every batch is read in a single operation in the worker thread with
+ * {@link LayerFeatures.nextBatchAsync}. The result set is released as soon as
+ * the last batch has been read or the iteration is interrupted, without waiting
+ * for the garbage collector.
+ *
+ * @example
+ * for await (const rows of ds.queryAsync('SELECT name, COUNT(*) AS n FROM cities GROUP BY name')) {
+ *   for (const row of rows) console.log(row.fields.name, row.fields.n)
+ * }
+ *
+ * @example
+ * const query = ds.queryAsync('SELECT * FROM roads', { batchSize: 10000, columnar: true, geometry: false })
+ * for await (const batch of query) {
+ *   total += batch.fields.length.reduce((a, x) => a + x, 0)
+ * }
+ *
+ * @method queryAsync
+ * @instance
+ * @memberof Dataset
+ * @param {string} statement SQL statement to execute
+ * @param {QueryOptions} [options]
+ * @return {AsyncIterableIterator<FeatureRow[]|FeatureColumns>}
+ */
+module.exports = (gdal) => function queryAsync(statement, options) {
+  options = options || {}
+  if (typeof statement !== 'string') throw new TypeError('statement must be a string')
+  const batchSize = options.batchSize === undefined ? 1000 : options.batchSize
+  if (!Number.isInteger(batchSize) || batchSize <= 0) throw new RangeError('batchSize must be a positive integer')
+  const batchOptions = { columnar: !!options.columnar, geometry: options.geometry !== false }
+
+  const ds = this
+  let layer = null
+  let done = false
+
+  const release = () => {
+    if (!layer) return Promise.resolve()
+    const results = layer
+    layer = null
+    return ds.releaseResultSetAsync(results)
+  }
+
+  const fetch = async () => {
+    if (done) return { done: true, value: undefined }
+    try {
+      if (!layer) {
+        layer = await ds.executeSQLAsync(statement, options.spatialFilter || null, options.dialect || null)
+      }
+      const batch = await layer.features.nextBatchAsync(batchSize, batchOptions)
+      const length = batchOptions.columnar ? batch.fid.length : batch.length
+      if (length < batchSize) {
+        // The last batch, release the results before returning it
+        done = true
+        await release()
+      }
+      if (length === 0) return { done: true, value: undefined }
+      return { done: false, value: batch }
+    } catch (e) {
+      done = true
+      await release().catch(() => undefined)
+      throw e
+    }
+  }
+
+  // The batches are read one after another even if next() is called
+  // without waiting for the previous one
+  let queue = Promise.resolve()
+  const enqueue = (fn) => {
+    const r = queue.then(fn)
+    queue = r.catch(() => undefined)
+    return r
+  }
+
+  return {
+    next: () => enqueue(fetch),
+    return: (value) => enqueue(async () => {
+      done = true
+      await release()
+      return { done: true, value }
+    }),
+    [Symbol.asyncIterator]() {
+      return this
+    }
+  }
+}
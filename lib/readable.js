@@ -9,9 +9,19 @@ const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_read|
  * @extends stream.ReadableOptions
  * @property {boolean} [blockOptimize]
  * @property {boolean} [convertNoData]
+ * @property {boolean} [skipEmpty]
+ * @property {number} [prefetch]
  * @property {new (len: number) => TypedArray} [type]
  */
 
+/**
+ * Marker replacing the pixels of an empty region in a {@link RasterReadStream}
+ * created with `skipEmpty`
+ *
+ * @typedef {object} RasterEmptyChunk
+ * @property {number} empty Number of skipped pixels
+ */
+
 /**
  * create a Readable stream from a raster band
  *
@@ -21,6 +31,8 @@ const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_read|
  * @param {RasterReadableOptions} [options]
  * @param {boolean} [options.blockOptimize=true] Read by file blocks when possible (when `rasterSize.x == blockSize.x`)
  * @param {boolean} [options.convertNoData=true] Automatically convert `RasterBand.noDataValue` to `NaN`
+ * @param {boolean} [options.skipEmpty=false] Do not read the regions without data, see {@link RasterReadStream}
+ * @param {number} [options.prefetch=0] Number of rows of blocks to announce in advance to the driver, useful only with the drivers implementing `AdviseRead`
  * @param {new (len: number) => TypedArray} [options.readAs=undefined] Data type to convert to, must be a `TypedArray` constructor
  * @returns {RasterReadStream}
  */
@@ -37,6 +49,14 @@ function createReadStream(options) {
  *
  * Pixels are streamed in row-major order
  *
+ * With `skipEmpty`, every row of blocks is checked with {@link RasterBand.getDataCoverageAsync}
+ * before being read, the rows reported as empty by the driver (missing blocks in sparse files)
+ * are neither read nor decoded and produce a {@link RasterEmptyChunk} instead of a `TypedArray`
+ *
+ * The next `prefetch` rows of blocks are announced to the driver with {@link RasterBand.adviseReadAsync},
+ * the drivers supporting it (JP2OpenJPEG, ECW, some network-backed formats) can fetch them while
+ * the current data is being processed
+ *
  * @class RasterReadStream
  * @extends stream.Readable
  * @constructor
@@ -44,6 +64,8 @@ function createReadStream(options) {
  * @param {RasterBand} options.band RasterBand to use
  * @param {boolean} [options.blockOptimize=true] Read by file blocks when possible (when `rasterSize.x == blockSize.x`)
  * @param {boolean} [options.convertNoData=false] Automatically convert `RasterBand.noDataValue` to `NaN`, requires float data types
+ * @param {boolean} [options.skipEmpty=false] Produce a {@link RasterEmptyChunk} instead of reading the empty regions
+ * @param {number} [options.prefetch=0] Number of rows of blocks to announce in advance with `adviseReadAsync`
  * @param {new (len: number) => TypedArray} [options.type=undefined] Data type to convert to, must be a `TypedArray` constructor, default is the raster band data type
  */
 class RasterReadStream extends Readable {
@@ -54,6 +76,13 @@ class RasterReadStream extends Readable {
     this.blockPos = 0
     this.readingInProgress = false
     this.rasterEnded = false
+    this.skipEmpty = !!options.skipEmpty
+    this.prefetch = options.prefetch === undefined ? 0 : options.prefetch
+    this.advisedPos = 0
+
+    if (!Number.isInteger(this.prefetch) || this.prefetch < 0) {
+      throw new RangeError('"prefetch" must be a non-negative integer')
+    }
 
     if (typeof options.type !== 'undefined') {
       try {
@@ -108,10 +137,10 @@ RasterReadStream.prototype._readNext = function () {
   this.readingInProgress = true
   this.initQ.then(() => {
     debug('do read')
-    this._readNextBuffer()
+    this._readNextChunk()
       .then((data) => {
         this.readingInProgress = false
-        this._convertNoData(data)
+        if (data.empty === undefined) this._convertNoData(data)
 
         debug('adding a new buffer', data.length)
         const flowing = this.push(data)
@@ -134,6 +163,35 @@ RasterReadStream.prototype._readNext = function () {
   })
 }
 
+// Announce the next rows of blocks that have not been announced yet,
+// the read that follows is queued after it on the Dataset lock
+RasterReadStream.prototype._adviseNext = function () {
+  const end = Math.min(this.rasterSize.y, this.readingPos + (this.prefetch + 1) * this.blockSize.y)
+  const start = Math.max(this.advisedPos, this.readingPos)
+  if (end <= start) return
+  this.advisedPos = end
+  debug('advise read', start, end)
+  this.band.adviseReadAsync(0, start, this.rasterSize.x, end - start)
+    .catch((e) => debug('advise read failed', e))
+}
+
+// Check the data coverage at the start of every row of blocks and
+// skip it when it is empty
+RasterReadStream.prototype._readNextChunk = function () {
+  if (this.readingPos % this.blockSize.y !== 0) return this._readNextBuffer()
+  if (this.prefetch > 0) this._adviseNext()
+  if (!this.skipEmpty) return this._readNextBuffer()
+  const rows = Math.min(this.blockSize.y, this.rasterSize.y - this.readingPos)
+  return this.band.getDataCoverageAsync(0, this.readingPos, this.rasterSize.x, rows)
+    .then((coverage) => {
+      if (coverage.data || !coverage.empty) return this._readNextBuffer()
+      debug('skipping empty rows', this.readingPos, rows)
+      this.readingPos += rows
+      this.blockPos += this._readNextBuffer === RasterReadStream.prototype._readNextBlock ? 1 : rows
+      return { empty: rows * this.rasterSize.x }
+    })
+}
+
 // Optimized reading when horizontally there is only one block (blockSize.x == rasterSize.x)
 // This is more often the case than not
 RasterReadStream.prototype._readNextBlock = function () {
@@ -23,6 +23,9 @@ const { fragment } = require('xmlbuilder2')
  *
  * Supports applying pixel functions.
  *
+ * {@link VRTBuilder} creates the VRT Dataset directly, without going through XML,
+ * and can do so asynchronously.
+ *
  * @example
  * // create a VRT dataset with a single band derived from the first
  * // band of the given dataset by applying the given pixel function
@@ -20,6 +20,7 @@ GDALProgressInfo::GDALProgressInfo() : complete(0), message(nullptr) {
 int ProgressTrampoline(double dfComplete, const char *pszMessage, void *pProgressArg) {
   GDALExecutionProgress *context = (GDALExecutionProgress *)pProgressArg;
   // The dispatcher in async.hpp will delete it
+  Trace::Progress(dfComplete);
   GDALProgressInfo *info = new GDALProgressInfo(dfComplete, pszMessage);
   // Go to the dispatcher
   context->Send(info);
@@ -69,4 +70,93 @@ void GDALSyncExecutionProgress::Send(GDALProgressInfo *info) const {
   if (try_catch.HasCaught()) throw "sync progress callback exception";
 }
 
+thread_local GDALErrorCapture *GDALErrorCapture::current = nullptr;
+
+GDALErrorCapture::GDALErrorCapture(bool replay) : errors(), replay(replay), parent(current) {
+  CPLPushErrorHandlerEx(handler, this);
+  CPLSetCurrentErrorHandlerCatchDebug(FALSE);
+  current = this;
+}
+
+GDALErrorCapture::~GDALErrorCapture() {
+  CPLPopErrorHandler();
+  current = parent;
+  if (parent != nullptr) {
+    for (auto const &e : errors) parent->record(e.level, e.code, e.message.c_str());
+    return;
+  }
+  if (!replay) return;
+  // CPLError() also sets the last error, it will be the same as before the replay
+  for (auto const &e : errors) CPLError(static_cast<CPLErr>(e.level), e.code, "%s", e.message.c_str());
+}
+
+void CPL_STDCALL GDALErrorCapture::handler(CPLErr level, int code, const char *msg) {
+  GDALErrorCapture *self = static_cast<GDALErrorCapture *>(CPLGetErrorHandlerUserData());
+  self->record(level, code, msg);
+}
+
+// Warning storms are capped, the outcome of a job depends only on the last error anyway
+void GDALErrorCapture::record(int level, int code, const char *msg) {
+  if (errors.size() >= maxRecords) return;
+  errors.push_back({level, code, msg != nullptr ? msg : ""});
+}
+
+const GDALErrorRecord *GDALErrorCapture::find(int code) const {
+  for (auto const &e : errors)
+    if (e.code == code) return &e;
+  return nullptr;
+}
+
+void GDALErrorCapture::Attach(v8::Local<v8::Value> target, const std::vector<GDALErrorRecord> &records) {
+  if (records.empty() || !target->IsObject()) return;
+  v8::Local<v8::Object> obj = target.As<v8::Object>();
+  // Do not touch the wrapped objects, they are shared and the same object can be returned by many jobs
+  // (this also excludes the TypedArrays)
+  if (obj->InternalFieldCount() > 0) return;
+
+  v8::Local<v8::Array> list = Nan::New<v8::Array>(records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    v8::Local<v8::Object> e = Nan::New<v8::Object>();
+    Nan::Set(e, Nan::New("code").ToLocalChecked(), Nan::New(records[i].code));
+    Nan::Set(e, Nan::New("message").ToLocalChecked(), SafeString::New(records[i].message.c_str()));
+    Nan::Set(e, Nan::New("level").ToLocalChecked(), Nan::New(records[i].level));
+    Nan::Set(list, i, e);
+  }
+  Nan::DefineOwnProperty(obj, Nan::New("cplErrors").ToLocalChecked(), list, v8::DontEnum);
+}
+
+unsigned asyncInlineThreshold = 0;
+const void *GDALAsyncMethodScope::current = nullptr;
+const char *GDALAsyncMethodScope::name = nullptr;
+std::map<long, int> GDALPendingJobs::pending;
+
+GDALJobCost *GDALJobCost::get(const void *method, int64_t size) {
+  static std::map<std::pair<const void *, int>, GDALJobCost> costs;
+  // One bucket per power of 2 of the input size
+  int bucket = -1;
+  if (size >= 0)
+    for (bucket = 0; size > 0; size >>= 1) bucket++;
+  // std::map never moves its elements
+  return &costs[{method, bucket}];
+}
+
+GDALPendingJobs::GDALPendingJobs(const std::vector<long> &uids) : uids(uids) {
+  for (long uid : uids)
+    if (uid != 0) pending[uid]++;
+}
+
+GDALPendingJobs::~GDALPendingJobs() {
+  for (long uid : uids) {
+    if (uid == 0) continue;
+    auto it = pending.find(uid);
+    if (it != pending.end() && --it->second <= 0) pending.erase(it);
+  }
+}
+
+bool GDALPendingJobs::any(const std::vector<long> &uids) {
+  for (long uid : uids)
+    if (uid != 0 && pending.count(uid) > 0) return true;
+  return false;
+}
+
 } // namespace node_gdal
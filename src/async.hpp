@@ -1,11 +1,14 @@
 #ifndef __NODE_GDAL_ASYNC_WORKER_H__
 #define __NODE_GDAL_ASYNC_WORKER_H__
 
+#include <atomic>
 #include <thread>
 #include <functional>
 #include <chrono>
+#include <map>
 #include "nan-wrapper.h"
 #include "gdal_common.hpp"
+#include "utils/trace.hpp"
 
 namespace node_gdal {
 
@@ -18,7 +21,7 @@ extern std::thread::id mainV8ThreadId;
     method##_do(info, false);                                                                                          \
   }                                                                                                                    \
   NAN_METHOD(method##Async) {                                                                                          \
-    method##_do(info, true);                                                                                           \
+    GDALAsyncableCall(info, method##_do, #method "Async");                                                             \
   }                                                                                                                    \
   void method##_do(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async)
 
@@ -28,6 +31,7 @@ extern std::thread::id mainV8ThreadId;
     method##_do(property, info, false);                                                                                \
   }                                                                                                                    \
   NAN_GETTER(method##Async) {                                                                                          \
+    GDALAsyncMethodScope scope(reinterpret_cast<const void *>(method##_do), #method "Async");                          \
     method##_do(property, info, true);                                                                                 \
   }                                                                                                                    \
   Nan::NAN_GETTER_RETURN_TYPE method##_do(v8::Local<v8::String> property, Nan::NAN_GETTER_ARGS_TYPE info, bool async)
@@ -55,7 +59,7 @@ extern std::thread::id mainV8ThreadId;
     method##_do(info, false);                                                                                          \
   }                                                                                                                    \
   static NAN_METHOD(method##Async) {                                                                                   \
-    method##_do(info, true);                                                                                           \
+    GDALAsyncableCall(info, method##_do, #method "Async");                                                             \
   }                                                                                                                    \
   static void method##_do(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async)
 
@@ -70,6 +74,104 @@ extern std::thread::id mainV8ThreadId;
   } else                                                                                                               \
     Nan::ThrowError(msg);
 
+// Cost model of the async jobs, used to run the cheapest ones inline
+//
+// Every async method keeps a moving average of the execution time of its main
+// lambda, separately for every order of magnitude of its input size when it is known
+// When the expected cost is below asyncInlineThreshold, a Promise-returning job
+// is run directly on the main thread if none of its datasets is locked and
+// no other async job is pending on them - the result is still delivered through the Promise
+class GDALJobCost {
+    public:
+  // Number of measurements before a method can be inlined
+  static const unsigned warmup = 8;
+
+  inline GDALJobCost() : average(0), samples(0) {
+  }
+  inline bool cheap(int64_t threshold_ns) const {
+    return samples.load(std::memory_order_relaxed) >= warmup && average.load(std::memory_order_relaxed) < threshold_ns;
+  }
+  // Called from the worker threads, the occasional lost update is not a problem
+  inline void record(int64_t ns) {
+    unsigned n = samples.fetch_add(1, std::memory_order_relaxed);
+    int64_t avg = average.load(std::memory_order_relaxed);
+    average.store(n == 0 ? ns : avg + (ns - avg) / 8, std::memory_order_relaxed);
+  }
+
+  // Main thread only, the returned pointer remains valid forever
+  static GDALJobCost *get(const void *method, int64_t size);
+
+    private:
+  std::atomic<int64_t> average;
+  std::atomic<unsigned> samples;
+};
+
+// Maximum expected cost in microseconds of an async job that can be run inline,
+// 0 (the default) disables, the cost of a method can change with its input
+// (a cache miss, a network file) and an inlined job blocks the event loop
+extern unsigned asyncInlineThreshold;
+
+// The async method currently being called on the main thread
+class GDALAsyncMethodScope {
+    public:
+  static const void *current;
+  // Used in the trace events
+  static const char *name;
+  inline GDALAsyncMethodScope(const void *method, const char *method_name)
+    : previous(current), previous_name(name) {
+    current = method;
+    name = method_name;
+  }
+  inline ~GDALAsyncMethodScope() {
+    current = previous;
+    name = previous_name;
+  }
+
+    private:
+  const void *previous;
+  const char *previous_name;
+};
+
+// Counts the async jobs queued on every dataset (main thread only),
+// the count is decremented when the worker is destroyed after delivering its result
+class GDALPendingJobs {
+    public:
+  GDALPendingJobs(const std::vector<long> &uids);
+  ~GDALPendingJobs();
+  static bool any(const std::vector<long> &uids);
+
+    private:
+  const std::vector<long> uids;
+  static std::map<long, int> pending;
+};
+
+// An async method returns a Promise unless its last argument is a callback
+inline bool GDALAsyncableHasCallback(const Nan::FunctionCallbackInfo<v8::Value> &info) {
+  return info.Length() > 0 && info[info.Length() - 1]->IsFunction();
+}
+
+// Entry point of all async methods
+// When returning a Promise, the exceptions thrown while parsing the arguments
+// must be delivered as a rejection, the callback flavor keeps throwing synchronously
+inline void GDALAsyncableCall(
+  const Nan::FunctionCallbackInfo<v8::Value> &info,
+  void (*method)(const Nan::FunctionCallbackInfo<v8::Value> &, bool),
+  const char *name) {
+  GDALAsyncMethodScope scope(reinterpret_cast<const void *>(method), name);
+  if (GDALAsyncableHasCallback(info)) {
+    method(info, true);
+    return;
+  }
+  Nan::TryCatch try_catch;
+  method(info, true);
+  if (try_catch.HasCaught()) {
+    auto context = Nan::GetCurrentContext();
+    auto resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+    resolver->Reject(context, try_catch.Exception()).FromJust();
+    info.GetReturnValue().Set(resolver->GetPromise());
+  }
+}
+
 // Handle locking (used only for sync methods)
 #define GDAL_LOCK_PARENT(p)                                                                                            \
   AsyncGuard lock;                                                                                                     \
@@ -127,6 +229,47 @@ class AsyncGuard {
   shared_ptr<vector<AsyncLock>> locks;
 };
 
+struct GDALErrorRecord {
+  int level;
+  int code;
+  std::string message;
+};
+
+// Collects the CPL errors and warnings emitted by the current thread
+// The handler is pushed on the thread-local GDAL error handler stack,
+// so neither the global handler, nor the other threads are involved
+// Debug messages are not captured and go to the global handler
+//
+// Nested captures pass their records to the enclosing one when they go out
+// of scope, the outermost capture replays them to the global handler if
+// asked to do so (used by code that does not run inside an async job)
+class GDALErrorCapture {
+    public:
+  static const size_t maxRecords = 100;
+
+  GDALErrorCapture(bool replay = false);
+  ~GDALErrorCapture();
+  inline const std::vector<GDALErrorRecord> &records() const {
+    return errors;
+  }
+  inline std::vector<GDALErrorRecord> take() {
+    return std::move(errors);
+  }
+  const GDALErrorRecord *find(int code) const;
+
+  // Attach to a JS value as the non-enumerable cplErrors property
+  static void Attach(v8::Local<v8::Value> target, const std::vector<GDALErrorRecord> &records);
+
+    private:
+  std::vector<GDALErrorRecord> errors;
+  bool replay;
+  GDALErrorCapture *parent;
+  static thread_local GDALErrorCapture *current;
+
+  void record(int level, int code, const char *msg);
+  static void CPL_STDCALL handler(CPLErr level, int code, const char *msg);
+};
+
 // Node.js NAN null initializes and trivially copies objects of this class without asking permission
 struct GDALProgressInfo {
   double complete;
@@ -198,6 +341,11 @@ template <class GDALType> class GDALAsyncWorker : public GDALAsyncProgressWorker
   const std::vector<long> ds_uids;
   GDALType raw;
 
+    protected:
+  std::vector<GDALErrorRecord> cplErrors;
+  const char *trace_name;
+  int64_t trace_bytes;
+
     public:
   explicit GDALAsyncWorker(
     Nan::Callback *resultCallback,
@@ -211,6 +359,10 @@ template <class GDALType> class GDALAsyncWorker : public GDALAsyncProgressWorker
 
   void Execute(const ExecutionProgress &progress);
   Local<Value> ProduceRVal();
+  inline void Trace(const char *name, int64_t bytes) {
+    trace_name = name;
+    trace_bytes = bytes;
+  }
   void HandleProgressCallback(const GDALProgressInfo *data, size_t count);
 };
 
@@ -228,7 +380,9 @@ GDALAsyncWorker<GDALType>::GDALAsyncWorker(
     // as they will be executed in async context!
     doit(doit),
     rval(rval),
-    ds_uids(ds_uids) {
+    ds_uids(ds_uids),
+    trace_name("GDALAsyncWorker"),
+    trace_bytes(-1) {
   // Main thread with the JS world is not running
   // Get persistent handles
   for (auto i = objects.begin(); i != objects.end(); i++) SaveToPersistent(i->first.c_str(), i->second);
@@ -243,11 +397,17 @@ template <class GDALType> Local<Value> GDALAsyncWorker<GDALType>::ProduceRVal()
 template <class GDALType> void GDALAsyncWorker<GDALType>::Execute(const ExecutionProgress &progress) {
   // Aux thread with the JS world running
   // V8 objects are not acessible here
+  GDALErrorCapture capture;
+  long uid = ds_uids.empty() ? 0 : ds_uids[0];
+  Trace::Scope job(trace_name, uid, trace_bytes);
   try {
     GDALExecutionProgress executionProgress(&progress);
+    Trace::Scope wait("lockDataset", uid);
     AsyncGuard lock(ds_uids);
+    wait.end();
     raw = doit(executionProgress);
   } catch (const char *err) { this->SetErrorMessage(err); }
+  cplErrors = capture.take();
 }
 
 template <class GDALType> GDALAsyncWorker<GDALType>::~GDALAsyncWorker() {
@@ -289,6 +449,7 @@ template <class GDALType> void GDALCallbackWorker<GDALType>::HandleOKCallback()
   // we give it a lambda that can access the persistent storage created for this operation
   // It uses our HandleScope so it can return a Local without escaping
   v8::Local<v8::Value> argv[] = {Nan::Null(), this->ProduceRVal()};
+  GDALErrorCapture::Attach(argv[1], this->cplErrors);
   this->callback->Call(2, argv, this->async_resource);
 }
 
@@ -296,6 +457,7 @@ template <class GDALType> void GDALCallbackWorker<GDALType>::HandleErrorCallback
   // Back to the main thread with the JS world not running
   Nan::HandleScope scope;
   v8::Local<v8::Value> argv[] = {Nan::Error(this->ErrorMessage())};
+  GDALErrorCapture::Attach(argv[0], this->cplErrors);
   this->callback->Call(1, argv, this->async_resource);
 }
 
@@ -311,7 +473,7 @@ template <class GDALType> class GDALPromiseWorker : public GDALAsyncWorker<GDALT
 
     public:
   explicit GDALPromiseWorker(
-    Nan::NAN_GETTER_ARGS_TYPE info,
+    Nan::Callback *progressCallback,
     const GDALMainFunc &doit,
     const GDALRValFunc &rval,
     const std::map<std::string, v8::Local<v8::Object>> &objects,
@@ -328,13 +490,13 @@ template <class GDALType> class GDALPromiseWorker : public GDALAsyncWorker<GDALT
 
 template <class GDALType>
 GDALPromiseWorker<GDALType>::GDALPromiseWorker(
-  Nan::NAN_GETTER_ARGS_TYPE info,
+  Nan::Callback *progressCallback,
   const GDALMainFunc &doit,
   const GDALRValFunc &rval,
   const std::map<std::string, v8::Local<v8::Object>> &objects,
   const std::vector<long> &ds_uids)
-  : GDALAsyncWorker<GDALType>(nullptr, nullptr, doit, rval, objects, ds_uids) {
-  auto context = info.GetIsolate()->GetCurrentContext();
+  : GDALAsyncWorker<GDALType>(nullptr, progressCallback, doit, rval, objects, ds_uids) {
+  auto context = Nan::GetCurrentContext();
   context_handle = new Nan::Persistent<v8::Context>(context);
   auto resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
   resolver_handle = new Nan::Persistent<v8::Promise::Resolver>(resolver);
@@ -344,14 +506,18 @@ template <class GDALType> void GDALPromiseWorker<GDALType>::HandleOKCallback() {
   Nan::HandleScope scope;
   v8::Local<v8::Context> context = Nan::New(*context_handle);
   v8::Local<v8::Promise::Resolver> resolver = Nan::New(*resolver_handle);
-  resolver->Resolve(context, this->ProduceRVal()).FromJust();
+  v8::Local<v8::Value> result = this->ProduceRVal();
+  GDALErrorCapture::Attach(result, this->cplErrors);
+  resolver->Resolve(context, result).FromJust();
 }
 
 template <class GDALType> void GDALPromiseWorker<GDALType>::HandleErrorCallback() {
   Nan::HandleScope scope;
   v8::Local<v8::Context> context = Nan::New(*context_handle);
   v8::Local<v8::Promise::Resolver> resolver = Nan::New(*resolver_handle);
-  resolver->Reject(context, Nan::Error(this->ErrorMessage())).FromJust();
+  v8::Local<v8::Value> error = Nan::Error(this->ErrorMessage());
+  GDALErrorCapture::Attach(error, this->cplErrors);
+  resolver->Reject(context, error).FromJust();
 }
 
 template <class GDALType> GDALPromiseWorker<GDALType>::~GDALPromiseWorker() {
@@ -392,10 +558,13 @@ template <class GDALType> class GDALAsyncableJob {
   // This is the lambda that produces the JS return object from the <GDALType> object
   GDALRValFunc rval;
   Nan::Callback *progress;
+  // The input size in bytes used by the cost model and the trace events, -1 when unknown
+  int64_t size;
 
-  GDALAsyncableJob(long ds_uid) : main(), rval(), progress(nullptr), persistent(), ds_uids({ds_uid}), autoIndex(0) {};
+  GDALAsyncableJob(long ds_uid)
+    : main(), rval(), progress(nullptr), size(-1), persistent(), ds_uids({ds_uid}), autoIndex(0) {};
   GDALAsyncableJob(std::vector<long> ds_uids)
-    : main(), rval(), progress(nullptr), persistent(), ds_uids(ds_uids), autoIndex(0) {};
+    : main(), rval(), progress(nullptr), size(-1), persistent(), ds_uids(ds_uids), autoIndex(0) {};
 
   inline void persist(const std::string &key, const v8::Local<v8::Object> &obj) {
     persistent[key] = obj;
@@ -418,9 +587,22 @@ template <class GDALType> class GDALAsyncableJob {
     if (!info.This().IsEmpty() && info.This()->IsObject()) persist("this", info.This());
     if (async) {
       if (progress) persist("progress_cb", progress->GetFunction());
-      Nan::Callback *callback;
-      NODE_ARG_CB(cb_arg, "callback", callback);
-      Nan::AsyncQueueWorker(new GDALCallbackWorker<GDALType>(callback, progress, main, rval, persistent, ds_uids));
+      Nan::Callback *callback = nullptr;
+      NODE_ARG_CB_OPT(cb_arg, "callback", callback);
+      // A callback must never be called synchronously
+      if (callback == nullptr && runInline(info.GetReturnValue())) return;
+      monitor();
+      if (callback != nullptr) {
+        auto worker = new GDALCallbackWorker<GDALType>(callback, progress, main, rval, persistent, ds_uids);
+        worker->Trace(traceName(), size);
+        Nan::AsyncQueueWorker(worker);
+        return;
+      }
+      // No callback -> resolve a Promise directly from C++
+      auto worker = new GDALPromiseWorker<GDALType>(progress, main, rval, persistent, ds_uids);
+      worker->Trace(traceName(), size);
+      info.GetReturnValue().Set(worker->Promise());
+      Nan::AsyncQueueWorker(worker);
       return;
     }
     try {
@@ -436,7 +618,10 @@ template <class GDALType> class GDALAsyncableJob {
   void run(Nan::NAN_GETTER_ARGS_TYPE info, bool async) {
     if (!info.This().IsEmpty() && info.This()->IsObject()) persist("this", info.This());
     if (async) {
-      auto worker = new GDALPromiseWorker<GDALType>(info, main, rval, persistent, ds_uids);
+      if (runInline(info.GetReturnValue())) return;
+      monitor();
+      auto worker = new GDALPromiseWorker<GDALType>(nullptr, main, rval, persistent, ds_uids);
+      worker->Trace(traceName(), size);
       info.GetReturnValue().Set(worker->Promise());
       Nan::AsyncQueueWorker(worker);
       return;
@@ -455,6 +640,73 @@ template <class GDALType> class GDALAsyncableJob {
   std::map<std::string, v8::Local<v8::Object>> persistent;
   const std::vector<long> ds_uids;
   unsigned autoIndex;
+
+  inline const char *traceName() {
+    return GDALAsyncMethodScope::name != nullptr ? GDALAsyncMethodScope::name : "GDALAsyncWorker";
+  }
+
+  inline GDALJobCost *cost() {
+    if (GDALAsyncMethodScope::current == nullptr) return nullptr;
+    return GDALJobCost::get(GDALAsyncMethodScope::current, size);
+  }
+
+  // Measure the execution time on the worker thread and
+  // keep track of the pending jobs until the worker is destroyed
+  void monitor() {
+    GDALJobCost *c = cost();
+    GDALMainFunc doit = main;
+    auto pending = std::make_shared<GDALPendingJobs>(ds_uids);
+    main = [doit, c, pending](const GDALExecutionProgress &progress) {
+      if (c == nullptr) return doit(progress);
+      auto start = std::chrono::steady_clock::now();
+      GDALType r = doit(progress);
+      c->record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      return r;
+    };
+  }
+
+  // Run a cheap job on the main thread resolving a Promise, returns false
+  // if the job must go through the thread pool
+  template <typename R> bool runInline(R ret) {
+    if (asyncInlineThreshold == 0 || progress != nullptr) return false;
+    GDALJobCost *c = cost();
+    if (c == nullptr || !c->cheap(static_cast<int64_t>(asyncInlineThreshold) * 1000)) return false;
+    if (GDALPendingJobs::any(ds_uids)) return false;
+
+    bool locked = true;
+    std::vector<AsyncLock> locks;
+    try {
+      locks = object_store.tryLockDatasets(ds_uids, locked);
+    } catch (const char *) {
+      // Let the worker produce the error
+      return false;
+    }
+    if (!locked) return false;
+
+    auto context = Nan::GetCurrentContext();
+    auto resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+    GDALErrorCapture capture;
+    Trace::Scope job(traceName(), ds_uids.empty() ? 0 : ds_uids[0], size);
+    try {
+      GDALExecutionProgress executionProgress(new GDALSyncExecutionProgress(nullptr));
+      auto start = std::chrono::steady_clock::now();
+      GDALType obj = main(executionProgress);
+      c->record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      // As in the worker path, rval runs without the locks
+      object_store.unlockDatasets(locks);
+      locks.clear();
+      v8::Local<v8::Value> result = rval(obj, [this](const char *key) { return this->persistent[key]; });
+      GDALErrorCapture::Attach(result, capture.records());
+      resolver->Resolve(context, result).FromJust();
+    } catch (const char *err) {
+      object_store.unlockDatasets(locks);
+      v8::Local<v8::Value> error = Nan::Error(err);
+      GDALErrorCapture::Attach(error, capture.records());
+      resolver->Reject(context, error).FromJust();
+    }
+    ret.Set(resolver->GetPromise());
+    return true;
+  }
 };
 } // namespace node_gdal
 #endif
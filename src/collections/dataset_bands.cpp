@@ -234,6 +234,11 @@ GDAL_ASYNCABLE_DEFINE(DatasetBands::count) {
     return;
   }
 
+  if (!async && ds->snapshot.valid) {
+    info.GetReturnValue().Set(Nan::New<Integer>(ds->snapshot.band_count));
+    return;
+  }
+
   GDALDataset *raw = ds->get();
   GDALAsyncableJob<int> job(ds->uid);
   job.persist(parent);
@@ -2,6 +2,11 @@
 #include "../gdal_common.hpp"
 #include "../gdal_feature.hpp"
 #include "../gdal_layer.hpp"
+#include "../geometry/gdal_geometry.hpp"
+#include "feature_fields.hpp"
+
+#include <memory>
+#include <vector>
 
 namespace node_gdal {
 
@@ -21,6 +26,7 @@ void LayerFeatures::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "set", set);
   Nan__SetPrototypeAsyncableMethod(lcons, "first", first);
   Nan__SetPrototypeAsyncableMethod(lcons, "next", next);
+  Nan__SetPrototypeAsyncableMethod(lcons, "nextBatch", nextBatch);
   Nan__SetPrototypeAsyncableMethod(lcons, "remove", remove);
 
   ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
@@ -225,6 +231,160 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::next) {
   job.run(info, async, 0);
 }
 
+/**
+ * @typedef {object} FeatureBatchOptions
+ * @property {boolean} [columnar=false] Return one array per column instead of one object per feature
+ * @property {boolean} [geometry=true] Include the geometries
+ */
+
+/**
+ * @typedef {object} FeatureRow
+ * @property {number} fid
+ * @property {Record<string, any>} fields
+ * @property {Geometry|null} [geometry]
+ */
+
+/**
+ * @typedef {object} FeatureColumns
+ * @property {number[]} fid
+ * @property {Record<string, any[]>} fields
+ * @property {(Geometry|null)[]} [geometry]
+ */
+
+/**
+ * Returns up to `count` next features of the layer as plain JS objects,
+ * either one object per feature or one array per column.
+ *
+ * Returns less than `count` features when the end of the layer has been reached.
+ *
+ * @example
+ *
+ * const batch = layer.features.nextBatch(1000, { columnar: true });
+ * const total = batch.fields.population.reduce((a, x) => a + x, 0);
+ *
+ * @method nextBatch
+ * @instance
+ * @memberof LayerFeatures
+ * @throws {Error}
+ * @param {number} count
+ * @param {FeatureBatchOptions} [options]
+ * @return {FeatureRow[]|FeatureColumns}
+ */
+
+/**
+ * Returns up to `count` next features of the layer as plain JS objects,
+ * either one object per feature or one array per column.
+ * @async
+ *
+ * The features are read in a single operation in the worker thread.
+ * Returns less than `count` features when the end of the layer has been reached.
+ *
+ * @example
+ *
+ * let batch;
+ * while ((batch = await layer.features.nextBatchAsync(1000)).length > 0) { ... }
+ *
+ * @method nextBatchAsync
+ * @instance
+ * @memberof LayerFeatures
+ * @throws {Error}
+ * @param {number} count
+ * @param {FeatureBatchOptions} [options]
+ * @param {callback<FeatureRow[]|FeatureColumns>} [callback=undefined]
+ * @return {Promise<FeatureRow[]|FeatureColumns>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::nextBatch) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int count;
+  Local<Object> options;
+  bool columnar = false;
+  bool geometry = true;
+  NODE_ARG_INT(0, "count", count);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_BOOL_FROM_OBJ_OPT(options, "columnar", columnar);
+    NODE_BOOL_FROM_OBJ_OPT(options, "geometry", geometry);
+  }
+  if (count <= 0) {
+    Nan::ThrowRangeError("count must be a positive integer");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::shared_ptr<std::vector<OGRFeatureUniquePtr>>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, count](const GDALExecutionProgress &) {
+    auto batch = std::make_shared<std::vector<OGRFeatureUniquePtr>>();
+    batch->reserve(count);
+    for (int i = 0; i < count; i++) {
+      OGRFeatureUniquePtr feature(gdal_layer->GetNextFeature());
+      if (feature == nullptr) break;
+      batch->push_back(std::move(feature));
+    }
+    // The conversion on the main thread cannot fail
+    if (!batch->empty()) {
+      OGRFeatureDefn *defn = batch->front()->GetDefnRef();
+      for (int i = 0; i < defn->GetFieldCount(); i++) {
+        OGRFieldType type = defn->GetFieldDefn(i)->GetType();
+        if (type == OFTWideString || type == OFTWideStringList) throw "Unsupported field type";
+      }
+    }
+    return batch;
+  };
+  job.rval = [columnar, geometry](
+               std::shared_ptr<std::vector<OGRFeatureUniquePtr>> batch, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    int n = static_cast<int>(batch->size());
+    OGRFeatureDefn *defn = n > 0 ? batch->front()->GetDefnRef() : nullptr;
+    int fields = defn ? defn->GetFieldCount() : 0;
+
+    if (columnar) {
+      Local<Object> result = Nan::New<Object>();
+      Local<Array> fid = Nan::New<Array>(n);
+      Local<Array> geom = Nan::New<Array>(n);
+      Local<Object> values = Nan::New<Object>();
+      std::vector<Local<Array>> columns;
+      for (int j = 0; j < fields; j++) {
+        columns.push_back(Nan::New<Array>(n));
+        Nan::Set(values, SafeString::New(defn->GetFieldDefn(j)->GetNameRef()), columns.back());
+      }
+      for (int i = 0; i < n; i++) {
+        OGRFeature *f = (*batch)[i].get();
+        Nan::Set(fid, i, Nan::New<Number>(f->GetFID()));
+        for (int j = 0; j < fields; j++) Nan::Set(columns[j], i, FeatureFields::get(f, j));
+        if (geometry) Nan::Set(geom, i, Geometry::New(f->StealGeometry(), true));
+      }
+      Nan::Set(result, Nan::New("fid").ToLocalChecked(), fid);
+      Nan::Set(result, Nan::New("fields").ToLocalChecked(), values);
+      if (geometry) Nan::Set(result, Nan::New("geometry").ToLocalChecked(), geom);
+      return scope.Escape(result.As<Value>());
+    }
+
+    Local<Array> result = Nan::New<Array>(n);
+    for (int i = 0; i < n; i++) {
+      OGRFeature *f = (*batch)[i].get();
+      Local<Object> row = Nan::New<Object>();
+      Local<Object> values = Nan::New<Object>();
+      for (int j = 0; j < fields; j++)
+        Nan::Set(values, SafeString::New(defn->GetFieldDefn(j)->GetNameRef()), FeatureFields::get(f, j));
+      Nan::Set(row, Nan::New("fid").ToLocalChecked(), Nan::New<Number>(f->GetFID()));
+      Nan::Set(row, Nan::New("fields").ToLocalChecked(), values);
+      if (geometry) Nan::Set(row, Nan::New("geometry").ToLocalChecked(), Geometry::New(f->StealGeometry(), true));
+      Nan::Set(result, i, row);
+    }
+    return scope.Escape(result.As<Value>());
+  };
+  job.run(info, async, 2);
+}
+
 /**
  * Adds a feature to the layer. The feature should be created using the current
  * layer as the definition.
@@ -279,10 +439,12 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::add) {
 
   OGRLayer *gdal_layer = layer->get();
   OGRFeature *gdal_f = f->get();
+  std::shared_ptr<LayerCache> cache = layer->cache;
   GDALAsyncableJob<int> job(layer->parent_uid);
   job.persist(layer->handle());
-  job.main = [gdal_layer, gdal_f](const GDALExecutionProgress &) {
+  job.main = [gdal_layer, gdal_f, cache](const GDALExecutionProgress &) {
     int err = gdal_layer->CreateFeature(gdal_f);
+    cache->modified();
     if (err != CE_None) throw getOGRErrMsg(err);
     return err;
   };
@@ -293,6 +455,8 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::add) {
 /**
  * Returns the number of features in the layer.
  *
+ * The result is cached until the filters are changed or the Dataset is modified.
+ *
  * @method count
  * @instance
  * @memberof LayerFeatures
@@ -304,6 +468,9 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::add) {
  * Returns the number of features in the layer.
  * @async
  *
+ * The result is cached until the filters are changed or the Dataset is modified,
+ * a cached value is returned without waiting for the Dataset to be available.
+ *
  * @method countAsync
  * @instance
  * @memberof LayerFeatures
@@ -333,11 +500,24 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::count) {
   int force = 1;
   NODE_ARG_BOOL_OPT(0, "force", force);
 
+  std::shared_ptr<LayerCache> cache = layer->cache;
+  GIntBig cached;
+  if (cache->getCount(cached)) {
+    // A cached value does not need the Dataset lock
+    GDALAsyncableJob<GIntBig> job(0);
+    job.main = [cached](const GDALExecutionProgress &) { return cached; };
+    job.rval = [](GIntBig count, const GetFromPersistentFunc &) { return Nan::New<Number>(count); };
+    job.run(info, async, 1);
+    return;
+  }
+
   OGRLayer *gdal_layer = layer->get();
   GDALAsyncableJob<GIntBig> job(layer->parent_uid);
   job.persist(layer->handle());
-  job.main = [gdal_layer, force](const GDALExecutionProgress &) {
+  job.main = [gdal_layer, force, cache](const GDALExecutionProgress &) {
     GIntBig count = gdal_layer->GetFeatureCount(force);
+    // An approximate count must not be returned for force=true
+    if (count >= 0 && force) cache->setCount(count);
     return count;
   };
   job.rval = [](GIntBig count, const GetFromPersistentFunc &) { return Nan::New<Number>(count); };
@@ -424,10 +604,12 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::set) {
 
   OGRLayer *gdal_layer = layer->get();
   OGRFeature *gdal_feature = f->get();
+  std::shared_ptr<LayerCache> cache = layer->cache;
   GDALAsyncableJob<OGRErr> job(layer->parent_uid);
   job.persist(layer->handle(), f->handle());
-  job.main = [gdal_layer, gdal_feature](const GDALExecutionProgress &) {
+  job.main = [gdal_layer, gdal_feature, cache](const GDALExecutionProgress &) {
     OGRErr err = gdal_layer->SetFeature(gdal_feature);
+    cache->modified();
     if (err != CE_None) throw getOGRErrMsg(err);
     return err;
   };
@@ -473,10 +655,12 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::remove) {
   NODE_ARG_INT(0, "feature id", i);
 
   OGRLayer *gdal_layer = layer->get();
+  std::shared_ptr<LayerCache> cache = layer->cache;
   GDALAsyncableJob<int> job(layer->parent_uid);
   job.persist(layer->handle());
-  job.main = [gdal_layer, i](const GDALExecutionProgress &) {
+  job.main = [gdal_layer, i, cache](const GDALExecutionProgress &) {
     int err = gdal_layer->DeleteFeature(i);
+    cache->modified();
     if (err) { throw getOGRErrMsg(err); }
     return err;
   };
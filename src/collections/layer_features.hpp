@@ -30,6 +30,7 @@ class LayerFeatures : public Nan::ObjectWrap {
   GDAL_ASYNCABLE_DECLARE(get);
   GDAL_ASYNCABLE_DECLARE(first);
   GDAL_ASYNCABLE_DECLARE(next);
+  GDAL_ASYNCABLE_DECLARE(nextBatch);
   GDAL_ASYNCABLE_DECLARE(count);
   GDAL_ASYNCABLE_DECLARE(add);
   GDAL_ASYNCABLE_DECLARE(set);
@@ -1,9 +1,13 @@
 #include "rasterband_pixels.hpp"
 #include "../gdal_common.hpp"
+#include "../gdal_cache.hpp"
 #include "../gdal_rasterband.hpp"
 #include "../async.hpp"
 #include "../utils/typed_array.hpp"
 
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <sstream>
 
 namespace node_gdal {
@@ -142,6 +146,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::get) {
 
   job.main = [raw, x, y](const GDALExecutionProgress &) {
     double val;
+    BlockCache::Accounting accounting(raw, x, y, 1, 1, 1, 1);
     CPLErrorReset();
     CPLErr err = raw->RasterIO(GF_Read, x, y, 1, 1, &val, 1, 1, GDT_Float64, 0, 0);
     if (err) { throw CPLGetLastErrorMsg(); }
@@ -193,6 +198,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::set) {
   job.persist(band->handle());
 
   job.main = [raw, x, y, val](const GDALExecutionProgress &) {
+    BlockCache::Accounting accounting(raw, x, y, 1, 1, 1, 1);
     CPLErrorReset();
     CPLErr err = raw->RasterIO(GF_Write, x, y, 1, 1, (void *)&val, 1, 1, GDT_Float64, 0, 0);
     if (err) { throw CPLGetLastErrorMsg(); }
@@ -203,62 +209,86 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::set) {
   job.run(info, async, 3);
 }
 
-inline GDALRIOResampleAlg parseResamplingAlg(Local<Value> value) {
-  if (value->IsUndefined() || value->IsNull()) { return GRIORA_NearestNeighbour; }
-  if (!value->IsString()) { throw "resampling property must be a string"; }
-  std::string name = *Nan::Utf8String(value);
-
-  if (name == "NearestNeighbor") { return GRIORA_NearestNeighbour; }
-  if (name == "NearestNeighbour") { return GRIORA_NearestNeighbour; }
-  if (name == "Bilinear") { return GRIORA_Bilinear; }
-  if (name == "Cubic") { return GRIORA_Cubic; }
-  if (name == "CubicSpline") { return GRIORA_CubicSpline; }
-  if (name == "Lanczos") { return GRIORA_Lanczos; }
-  if (name == "Average") { return GRIORA_Average; }
-  if (name == "Mode") { return GRIORA_Mode; }
-  if (name == "Gauss") { return GRIORA_Gauss; }
-
-  throw "Invalid resampling algorithm";
-}
-
-/* Find the lowest possible element index for the given width, height, pixel_space, line_space and offset */
-static inline int64_t findLowest(int64_t w, int64_t h, int64_t px, int64_t ln, int64_t offset) {
-  int64_t x, y;
-
-  if (px < 0)
-    x = w - 1;
-  else
-    x = 0;
-
-  if (ln < 0)
-    y = h - 1;
-  else
-    y = 0;
+/**
+ * @typedef {T extends number ? Uint8Array | Int16Array | Uint16Array | Int32Array | Uint32Array | import('@petamoriken/float16').Float16Array | Float32Array | Float64Array : T extends bigint ? BigInt64Array | BigUint64Array : never} TypedArray<T = number>
+ * @memberof RasterBandPixels
+ */
 
-  return offset + (x * px + y * ln);
+// Derive the nodata mask from the data that has just been read,
+// GDALNoDataMaskBand compares the values in the same way
+template <typename T>
+static void nodataMask(
+  const uint8_t *data, uint8_t *mask, int w, int h, int pixel_space, int line_space, double nodata) {
+  const T nd = static_cast<T>(nodata);
+  for (int j = 0; j < h; j++) {
+    const uint8_t *line = data + static_cast<int64_t>(j) * line_space;
+    uint8_t *m = mask + static_cast<int64_t>(j) * w;
+    for (int i = 0; i < w; i++) {
+      T v;
+      memcpy(&v, line + static_cast<int64_t>(i) * pixel_space, sizeof(T));
+      m[i] = v == nd ? 0 : 255;
+    }
+  }
 }
 
-/* Find the highest possible element index for the given width, height, pixel_space, line_space and offset */
-static inline int64_t findHighest(int64_t w, int64_t h, int64_t px, int64_t ln, int64_t offset) {
-  int64_t x, y;
-
-  if (px < 0)
-    x = 0;
-  else
-    x = w - 1;
-
-  if (ln < 0)
-    y = 0;
-  else
-    y = h - 1;
+template <typename T>
+static void nodataMaskReal(
+  const uint8_t *data, uint8_t *mask, int w, int h, int pixel_space, int line_space, double nodata) {
+  const T nd = static_cast<T>(nodata);
+  const bool nan = std::isnan(nodata);
+  for (int j = 0; j < h; j++) {
+    const uint8_t *line = data + static_cast<int64_t>(j) * line_space;
+    uint8_t *m = mask + static_cast<int64_t>(j) * w;
+    for (int i = 0; i < w; i++) {
+      T v;
+      memcpy(&v, line + static_cast<int64_t>(i) * pixel_space, sizeof(T));
+      m[i] = (nan ? std::isnan(v) : ARE_REAL_EQUAL(v, nd)) ? 0 : 255;
+    }
+  }
+}
 
-  return offset + (x * px + y * ln);
+template <typename T> static bool nodataInRange(double nodata) {
+  return nodata >= static_cast<double>(std::numeric_limits<T>::lowest()) &&
+    nodata <= static_cast<double>(std::numeric_limits<T>::max()) && nodata == std::floor(nodata);
 }
 
-/**
- * @typedef {T extends number ? Uint8Array | Int16Array | Uint16Array | Int32Array | Uint32Array | import('@petamoriken/float16').Float16Array | Float32Array | Float64Array : T extends bigint ? BigInt64Array | BigUint64Array : never} TypedArray<T = number>
- * @memberof RasterBandPixels
- */
+// Returns false if the mask cannot be derived from the data of this type
+static bool nodataMask(
+  GDALDataType type, const uint8_t *data, uint8_t *mask, int w, int h, int pixel_space, int line_space, double nodata) {
+  bool valid;
+  switch (type) {
+    case GDT_Byte: valid = nodataInRange<uint8_t>(nodata); break;
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 7)
+    case GDT_Int8: valid = nodataInRange<int8_t>(nodata); break;
+#endif
+    case GDT_UInt16: valid = nodataInRange<uint16_t>(nodata); break;
+    case GDT_Int16: valid = nodataInRange<int16_t>(nodata); break;
+    case GDT_UInt32: valid = nodataInRange<uint32_t>(nodata); break;
+    case GDT_Int32: valid = nodataInRange<int32_t>(nodata); break;
+    case GDT_Float32:
+    case GDT_Float64: valid = true; break;
+    default: return false;
+  }
+  // A nodata value that cannot appear in the data
+  if (!valid) {
+    for (int j = 0; j < h; j++) memset(mask + static_cast<int64_t>(j) * w, 255, w);
+    return true;
+  }
+  switch (type) {
+    case GDT_Byte: nodataMask<uint8_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 7)
+    case GDT_Int8: nodataMask<int8_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+#endif
+    case GDT_UInt16: nodataMask<uint16_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    case GDT_Int16: nodataMask<int16_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    case GDT_UInt32: nodataMask<uint32_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    case GDT_Int32: nodataMask<int32_t>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    case GDT_Float32: nodataMaskReal<float>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    case GDT_Float64: nodataMaskReal<double>(data, mask, w, h, pixel_space, line_space, nodata); break;
+    default: return false;
+  }
+  return true;
+}
 
 /**
  * @typedef {object} ReadOptions
@@ -272,6 +302,70 @@ static inline int64_t findHighest(int64_t w, int64_t h, int64_t px, int64_t ln,
  * @property {string} [resampling]
  * @property {ProgressCb} [progress_cb]
  * @property {number} [offset]
+ * @property {boolean} [withMask]
+ */
+
+/**
+ * @typedef {object} ReadWithMaskOptions
+ * @memberof RasterBandPixels
+ * @extends ReadOptions
+ * @property {true} withMask
+ */
+
+/**
+ * @typedef {object} MaskedPixels
+ * @memberof RasterBandPixels
+ * @property {TypedArray} data
+ * @property {Uint8Array} mask `0` for the invalid pixels and `255` for the valid pixels
+ */
+
+/**
+ * Reads a region of pixels and the same region of the mask band.
+ *
+ * The mask is read in the same operation. When the mask is defined by the nodata
+ * value and the data is read without conversion or resampling, it is computed
+ * from the data instead of being read from the mask band.
+ *
+ * @example
+ *
+ * const { data, mask } = band.pixels.read(0, 0, 256, 256, undefined, { withMask: true });
+ *
+ * @method read
+ * @instance
+ * @memberof RasterBandPixels
+ * @throws {Error}
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray|undefined} data The `TypedArray` to put the data in. A new array is created if not given.
+ * @param {ReadWithMaskOptions} options
+ * @return {MaskedPixels}
+ */
+
+/**
+ * Asynchronously reads a region of pixels and the same region of the mask band.
+ * @async
+ *
+ * The mask is read in the same operation. When the mask is defined by the nodata
+ * value and the data is read without conversion or resampling, it is computed
+ * from the data instead of being read from the mask band.
+ *
+ * @example
+ *
+ * const { data, mask } = await band.pixels.readAsync(0, 0, 256, 256, undefined, { withMask: true });
+ *
+ * @method readAsync
+ * @instance
+ * @memberof RasterBandPixels
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray|undefined} data The `TypedArray` to put the data in. A new array is created if not given.
+ * @param {ReadWithMaskOptions} options
+ * @param {callback<MaskedPixels>} [callback=undefined]
+ * @return {Promise<MaskedPixels>}
  */
 
 /**
@@ -382,6 +476,8 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
   }
   offset = 0;
   NODE_ARG_INT_OPT(12, "offset", offset);
+  bool with_mask = false;
+  NODE_ARG_BOOL_OPT(13, "withMask", with_mask);
 
   if (findLowest(buffer_w, buffer_h, pixel_space, line_space, offset) < 0) {
     Nan::ThrowError("has to write before the start of the TypedArray");
@@ -405,18 +501,44 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
     return; // TypedArray::Validate threw an error
   }
 
+  uint8_t *mask = nullptr;
+  Local<Object> mask_obj;
+  if (with_mask) {
+    Local<Value> mask_array = TypedArray::New(GDT_Byte, static_cast<int64_t>(buffer_w) * buffer_h);
+    if (mask_array.IsEmpty() || !mask_array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    mask_obj = mask_array.As<Object>();
+    mask = static_cast<uint8_t *>(TypedArray::Validate(mask_obj, GDT_Byte, static_cast<int64_t>(buffer_w) * buffer_h));
+    if (!mask) return;
+  }
+
   GDALRasterBand *gdal_band = band->get();
 #ifdef DEBUG_MACOS_FREEZE
   printf("RasterBandPixels::read acquire dataset\n");
 #endif
   GDALAsyncableJob<CPLErr> job(band->parent_uid);
   job.persist("array", obj);
+  if (with_mask) job.persist("mask", mask_obj);
   job.persist(band->handle());
   job.progress = cb;
+  job.size = static_cast<int64_t>(buffer_w) * buffer_h * (bytes_per_pixel + (with_mask ? 1 : 0));
 
   data = (uint8_t *)data + offset * bytes_per_pixel;
-  job.main = [gdal_band, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, resampling, cb](
-               const GDALExecutionProgress &progress) {
+  job.main = [gdal_band,
+              x,
+              y,
+              w,
+              h,
+              data,
+              mask,
+              buffer_w,
+              buffer_h,
+              type,
+              pixel_space,
+              line_space,
+              resampling,
+              cb](const GDALExecutionProgress &progress) {
 #ifdef DEBUG_MACOS_FREEZE
     printf("RasterBandPixels::read execute\n");
 #endif
@@ -428,6 +550,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
       extra->pProgressData = (void *)&progress;
     }
 
+    BlockCache::Accounting accounting(gdal_band, x, y, w, h, buffer_w, buffer_h);
     CPLErrorReset();
     CPLErr err =
       gdal_band->RasterIO(GF_Read, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, extra.get());
@@ -436,19 +559,44 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
 #endif
 
     if (err != CE_None) throw CPLGetLastErrorMsg();
+
+    if (mask != nullptr) {
+      int flags = gdal_band->GetMaskFlags();
+      int has_nodata = 0;
+      double nodata = gdal_band->GetNoDataValue(&has_nodata);
+      if (flags == GMF_ALL_VALID) {
+        memset(mask, 255, static_cast<size_t>(buffer_w) * buffer_h);
+      } else if (
+        flags == GMF_NODATA && has_nodata && type == gdal_band->GetRasterDataType() && buffer_w == w &&
+        buffer_h == h &&
+        nodataMask(type, static_cast<uint8_t *>(data), mask, w, h, pixel_space, line_space, nodata)) {
+        // The mask has been computed from the data
+      } else {
+        extra->pfnProgress = nullptr;
+        extra->pProgressData = nullptr;
+        err = gdal_band->GetMaskBand()->RasterIO(
+          GF_Read, x, y, w, h, mask, buffer_w, buffer_h, GDT_Byte, 1, buffer_w, extra.get());
+        if (err != CE_None) throw CPLGetLastErrorMsg();
+      }
+    }
     return err;
   };
 
-  job.rval = [](CPLErr err, const GetFromPersistentFunc &getter) {
+  job.rval = [with_mask](CPLErr err, const GetFromPersistentFunc &getter) {
 #ifdef DEBUG_MACOS_FREEZE
     printf("RasterBandPixels::read return result to JS\n");
 #endif
-    return getter("array");
+    if (!with_mask) return getter("array");
+    Nan::EscapableHandleScope scope;
+    Local<Object> r = Nan::New<Object>();
+    Nan::Set(r, Nan::New("data").ToLocalChecked(), getter("array"));
+    Nan::Set(r, Nan::New("mask").ToLocalChecked(), getter("mask"));
+    return scope.Escape(r.As<Value>());
   };
 #ifdef DEBUG_MACOS_FREEZE
   printf("RasterBandPixels::read schedule\n");
 #endif
-  job.run(info, async, 13);
+  job.run(info, async, 14);
 }
 
 /**
@@ -565,6 +713,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::write) {
   GDALAsyncableJob<CPLErr> job(band->parent_uid);
   job.persist("array", passed_array);
   job.persist(band->handle());
+  job.size = static_cast<int64_t>(buffer_w) * buffer_h * bytes_per_pixel;
   if (cb) {
     job.persist(cb->GetFunction());
     job.progress = cb;
@@ -580,6 +729,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::write) {
       extra->pProgressData = (void *)&progress;
     }
 
+    BlockCache::Accounting accounting(gdal_band, x, y, w, h, buffer_w, buffer_h);
     CPLErrorReset();
     CPLErr err =
       gdal_band->RasterIO(GF_Write, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, extra.get());
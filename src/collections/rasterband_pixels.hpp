@@ -14,11 +14,65 @@
 #include "../gdal_rasterband.hpp"
 #include "../async.hpp"
 
+#include <string>
+
 using namespace v8;
 using namespace node;
 
 namespace node_gdal {
 
+/* Find the lowest possible element index for the given width, height, pixel_space, line_space and offset */
+inline int64_t findLowest(int64_t w, int64_t h, int64_t px, int64_t ln, int64_t offset) {
+  int64_t x, y;
+
+  if (px < 0)
+    x = w - 1;
+  else
+    x = 0;
+
+  if (ln < 0)
+    y = h - 1;
+  else
+    y = 0;
+
+  return offset + (x * px + y * ln);
+}
+
+/* Find the highest possible element index for the given width, height, pixel_space, line_space and offset */
+inline int64_t findHighest(int64_t w, int64_t h, int64_t px, int64_t ln, int64_t offset) {
+  int64_t x, y;
+
+  if (px < 0)
+    x = 0;
+  else
+    x = w - 1;
+
+  if (ln < 0)
+    y = 0;
+  else
+    y = h - 1;
+
+  return offset + (x * px + y * ln);
+}
+
+inline GDALRIOResampleAlg parseResamplingAlg(Local<Value> value) {
+  if (value->IsUndefined() || value->IsNull()) { return GRIORA_NearestNeighbour; }
+  if (!value->IsString()) { throw "resampling property must be a string"; }
+  std::string name = *Nan::Utf8String(value);
+
+  if (name == "NearestNeighbor") { return GRIORA_NearestNeighbour; }
+  if (name == "NearestNeighbour") { return GRIORA_NearestNeighbour; }
+  if (name == "Bilinear") { return GRIORA_Bilinear; }
+  if (name == "Cubic") { return GRIORA_Cubic; }
+  if (name == "CubicSpline") { return GRIORA_CubicSpline; }
+  if (name == "Lanczos") { return GRIORA_Lanczos; }
+  if (name == "Average") { return GRIORA_Average; }
+  if (name == "Mode") { return GRIORA_Mode; }
+  if (name == "Gauss") { return GRIORA_Gauss; }
+
+  throw "Invalid resampling algorithm";
+}
+
 class RasterBandPixels : public Nan::ObjectWrap {
     public:
   static Nan::Persistent<FunctionTemplate> constructor;
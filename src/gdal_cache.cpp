@@ -0,0 +1,176 @@
+#include "gdal_cache.hpp"
+#include "utils/io_stats.hpp"
+
+#include <algorithm>
+
+namespace node_gdal {
+
+/**
+ * GDAL raster block cache.
+ *
+ * GDAL keeps the recently used raster blocks of all datasets in a single global cache
+ * whose size is controlled by the `GDAL_CACHEMAX` configuration option.
+ *
+ * @namespace cache
+ */
+
+BlockCache::Counters BlockCache::counters;
+std::atomic<bool> BlockCache::tracking(false);
+
+void BlockCache::Initialize(Local<Object> target) {
+  Local<Object> cache = Nan::New<Object>();
+  Nan::Set(target, Nan::New("cache").ToLocalChecked(), cache);
+  Nan::SetMethod(cache, "stats", stats);
+  Nan::SetMethod(cache, "resetStats", resetStats);
+  Nan::SetMethod(cache, "trackStats", trackStats);
+  Nan::SetMethod(cache, "setMax", setMax);
+}
+
+BlockCache::Accounting::Accounting(GDALRasterBand *band, int x, int y, int w, int h, int buffer_w, int buffer_h)
+  : used(0), block_bytes(0), misses(0) {
+  // Looking up the blocks is not free, this is done only when someone is interested
+  bool global = tracking;
+  std::shared_ptr<IOStats> stats = IOStats::get(band->GetDataset());
+  if (!global && !stats) return;
+  // A resampled operation can use an overview instead of the band itself
+  if (w != buffer_w || h != buffer_h) return;
+  int block_w, block_h;
+  band->GetBlockSize(&block_w, &block_h);
+  // Invalid windows will be rejected by the I/O operation itself
+  if (block_w <= 0 || block_h <= 0 || w <= 0 || h <= 0 || x < 0 || y < 0) return;
+  int last_x = std::min(x + w, band->GetXSize()) - 1;
+  int last_y = std::min(y + h, band->GetYSize()) - 1;
+  if (last_x < x || last_y < y) return;
+  block_bytes = static_cast<GInt64>(block_w) * block_h * GDALGetDataTypeSizeBytes(band->GetRasterDataType());
+
+  uint64_t hits = 0;
+  for (int by = y / block_h; by <= last_y / block_h; by++) {
+    for (int bx = x / block_w; bx <= last_x / block_w; bx++) {
+      GDALRasterBlock *block = band->TryGetLockedBlockRef(bx, by);
+      if (block != nullptr) {
+        block->DropLock();
+        hits++;
+      } else {
+        misses++;
+      }
+    }
+  }
+  if (stats) {
+    stats->cache_hits += hits;
+    stats->block_decodes += misses;
+  }
+  if (!global) {
+    // evictions are global only
+    misses = 0;
+    return;
+  }
+  counters.hits += hits;
+  counters.misses += misses;
+  used = GDALGetCacheUsed64();
+}
+
+BlockCache::Accounting::~Accounting() {
+  if (misses == 0 || block_bytes == 0) return;
+  // Every missing block that was loaded should have increased the cache size,
+  // if it did not, then as many bytes were evicted
+  // (this is only an estimation when several operations run at the same time)
+  GInt64 evicted = used + static_cast<GInt64>(misses) * block_bytes - GDALGetCacheUsed64();
+  if (evicted > 0) counters.evictions += (evicted + block_bytes - 1) / block_bytes;
+}
+
+/**
+ * @typedef {object} CacheStats
+ * @memberof cache
+ * @property {number} used Bytes currently used by the block cache
+ * @property {number} max Maximum size of the block cache in bytes
+ * @property {number} hits Blocks found in the cache
+ * @property {number} misses Blocks that had to be read
+ * @property {number} evictions Estimated number of blocks evicted from the cache
+ */
+
+/**
+ * Get the block cache statistics.
+ *
+ * `used` and `max` are global, `hits`, `misses` and `evictions` count only
+ * the blocks of the windows read or written through the `RasterBandPixels` methods
+ * while the tracking is enabled by `trackStats()` since the last call of `resetStats()` -
+ * I/O performed internally by GDAL, for example while warping, and the resampled
+ * reads and writes, which can use the overviews, are not included.
+ *
+ * All counts are estimates obtained by looking up the blocks in the cache
+ * before every operation: the blocks of the drivers that bypass the block cache,
+ * such as MEM or those using direct I/O, are always counted as misses
+ * and `evictions` is inferred from the evolution of the cache size.
+ *
+ * @static
+ * @method stats
+ * @memberof cache
+ * @returns {CacheStats}
+ */
+NAN_METHOD(BlockCache::stats) {
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("used").ToLocalChecked(), Nan::New<Number>(static_cast<double>(GDALGetCacheUsed64())));
+  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(static_cast<double>(GDALGetCacheMax64())));
+  Nan::Set(result, Nan::New("hits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(counters.hits.load())));
+  Nan::Set(
+    result, Nan::New("misses").ToLocalChecked(), Nan::New<Number>(static_cast<double>(counters.misses.load())));
+  Nan::Set(
+    result, Nan::New("evictions").ToLocalChecked(), Nan::New<Number>(static_cast<double>(counters.evictions.load())));
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Reset the hits, misses and evictions counters.
+ *
+ * @static
+ * @method resetStats
+ * @memberof cache
+ */
+NAN_METHOD(BlockCache::resetStats) {
+  counters.hits = 0;
+  counters.misses = 0;
+  counters.evictions = 0;
+}
+
+/**
+ * Enable or disable the tracking of the block cache hits, misses and evictions.
+ *
+ * It is disabled by default as it adds a lookup of every block
+ * to every `RasterBandPixels` operation.
+ *
+ * @static
+ * @method trackStats
+ * @memberof cache
+ * @param {boolean} enable
+ * @throws {Error}
+ */
+NAN_METHOD(BlockCache::trackStats) {
+  bool enable;
+  NODE_ARG_BOOL(0, "enable", enable);
+  tracking = enable;
+}
+
+/**
+ * Set the maximum size of the block cache in bytes.
+ *
+ * Reducing the size immediately evicts the least recently used blocks.
+ * Setting the `GDAL_CACHEMAX` configuration option has no effect once
+ * the cache has been used.
+ *
+ * @static
+ * @method setMax
+ * @memberof cache
+ * @param {number} bytes
+ * @throws {Error}
+ */
+NAN_METHOD(BlockCache::setMax) {
+  double bytes;
+  NODE_ARG_DOUBLE(0, "bytes", bytes);
+  if (bytes < 0) {
+    Nan::ThrowRangeError("bytes must be positive");
+    return;
+  }
+  GDALSetCacheMax64(static_cast<GIntBig>(bytes));
+}
+
+} // namespace node_gdal
@@ -0,0 +1,62 @@
+#ifndef __NODE_GDAL_CACHE_H__
+#define __NODE_GDAL_CACHE_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "gdal_common.hpp"
+
+#include <atomic>
+
+using namespace v8;
+using namespace node;
+
+// The GDAL raster block cache
+
+namespace node_gdal {
+
+namespace BlockCache {
+
+void Initialize(Local<Object> target);
+NAN_METHOD(stats);
+NAN_METHOD(resetStats);
+NAN_METHOD(trackStats);
+NAN_METHOD(setMax);
+
+// Counters of the raster I/O performed through gdal-async
+// GDAL does not instrument its block cache, so these are estimated
+// by looking up the blocks of the band before every I/O operation
+// This is done only when enabled by trackStats() or for the datasets
+// opened with the "s" mode
+struct Counters {
+  std::atomic<uint64_t> hits;
+  std::atomic<uint64_t> misses;
+  std::atomic<uint64_t> evictions;
+};
+extern Counters counters;
+extern std::atomic<bool> tracking;
+
+// Accounts for an I/O operation on a window of a band,
+// must be constructed before the I/O, the evictions are
+// estimated from the evolution of the cache size when it goes out of scope
+// Resampled operations are not counted as they can use the overviews
+class Accounting {
+    public:
+  Accounting(GDALRasterBand *band, int x, int y, int w, int h, int buffer_w, int buffer_h);
+  ~Accounting();
+
+    private:
+  GInt64 used;
+  GInt64 block_bytes;
+  uint64_t misses;
+};
+
+} // namespace BlockCache
+} // namespace node_gdal
+#endif
@@ -1,6 +1,7 @@
 #ifndef __GDAL_COMMON_H__
 #define __GDAL_COMMON_H__
 
+#include <cpl_conv.h>
 #include <cpl_error.h>
 #include <gdal_version.h>
 #include <thread>
@@ -10,22 +11,21 @@
 #include "nan-wrapper.h"
 
 #include "utils/ptr_manager.hpp"
+#include "utils/logger.hpp"
 
 #if GDAL_VERSION_MAJOR < 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR < 2)
 #error gdal-async now requires GDAL >= 2.2, downgrade to gdal-async@3.6.x for earlier versions
 #endif
 
 namespace node_gdal {
-extern FILE *log_file;
 extern ObjectStore object_store;
 extern bool eventLoopWarn;
 } // namespace node_gdal
 
 #ifdef ENABLE_LOGGING
 #define LOG(fmt, ...)                                                                                                  \
-  if (node_gdal::log_file) {                                                                                           \
-    fprintf(node_gdal::log_file, fmt "\n", __VA_ARGS__);                                                               \
-    fflush(node_gdal::log_file);                                                                                       \
+  if (node_gdal::logger.enabled(node_gdal::LogLevel::Debug)) {                                                         \
+    node_gdal::logger.log(node_gdal::LogLevel::Debug, fmt, __VA_ARGS__);                                               \
   }
 #else
 #define LOG(fmt, ...)
@@ -70,6 +70,28 @@ template <typename T> struct array_deleter {
   }
 };
 
+// Sets a GDAL configuration option for the current thread until the end of the scope,
+// an empty value leaves the option unchanged
+class ThreadLocalConfigOption {
+    public:
+  ThreadLocalConfigOption(const char *key, const std::string &value) : key(key), active(!value.empty()) {
+    if (!active) return;
+    const char *previous = CPLGetThreadLocalConfigOption(key, nullptr);
+    had_previous = previous != nullptr;
+    if (had_previous) this->previous = previous;
+    CPLSetThreadLocalConfigOption(key, value.c_str());
+  }
+  ~ThreadLocalConfigOption() {
+    if (active) CPLSetThreadLocalConfigOption(key, had_previous ? previous.c_str() : nullptr);
+  }
+
+    private:
+  const char *key;
+  bool active;
+  bool had_previous = false;
+  std::string previous;
+};
+
 template <typename INPUT, typename RETURN>
 std::shared_ptr<RETURN> NumberArrayToSharedPtr(Local<Array> array, size_t count = 0) {
   if (array.IsEmpty()) return nullptr;
@@ -319,6 +341,19 @@ NAN_SETTER(READ_ONLY_SETTER);
     }                                                                                                                  \
   }
 
+#define NODE_BOOL_FROM_OBJ_OPT(obj, key, var)                                                                          \
+  {                                                                                                                    \
+    Local<String> sym = Nan::New(key).ToLocalChecked();                                                                \
+    if (Nan::HasOwnProperty(obj, sym).FromMaybe(false)) {                                                              \
+      Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();                                                          \
+      if (!val->IsBoolean()) {                                                                                         \
+        Nan::ThrowTypeError("Property \"" key "\" must be a boolean");                                                 \
+        return;                                                                                                        \
+      }                                                                                                                \
+      var = Nan::To<bool>(val).ToChecked();                                                                            \
+    }                                                                                                                  \
+  }
+
 #define NODE_CB_FROM_OBJ_OPT(obj, key, var)                                                                            \
   {                                                                                                                    \
     var = nullptr;                                                                                                     \
@@ -2,6 +2,8 @@
 #include "gdal_group.hpp"
 #include "collections/dataset_bands.hpp"
 #include "collections/dataset_layers.hpp"
+#include "collections/colortable.hpp"
+#include "collections/rasterband_pixels.hpp"
 #include "gdal_common.hpp"
 #include "gdal_driver.hpp"
 #include "geometry/gdal_geometry.hpp"
@@ -9,7 +11,11 @@
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/io_stats.hpp"
 #include "utils/string_list.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
 
 namespace node_gdal {
 
@@ -23,17 +29,23 @@ void Dataset::Initialize(Local<Object> target) {
   lcons->SetClassName(Nan::New("Dataset").ToLocalChecked());
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetMethod(lcons, "fromTypedArrays", fromTypedArrays);
   Nan::SetPrototypeMethod(lcons, "setGCPs", setGCPs);
   Nan::SetPrototypeMethod(lcons, "getGCPs", getGCPs);
   Nan::SetPrototypeMethod(lcons, "getGCPProjection", getGCPProjection);
   Nan::SetPrototypeMethod(lcons, "getFileList", getFileList);
+  Nan::SetPrototypeMethod(lcons, "ioStats", ioStats);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", flush);
   Nan::SetPrototypeMethod(lcons, "close", close);
   Nan__SetPrototypeAsyncableMethod(lcons, "getMetadata", getMetadata);
   Nan__SetPrototypeAsyncableMethod(lcons, "setMetadata", setMetadata);
+  Nan__SetPrototypeAsyncableMethod(lcons, "describe", describe);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "executeSQL", executeSQL);
+  Nan__SetPrototypeAsyncableMethod(lcons, "releaseResultSet", releaseResultSet);
   Nan__SetPrototypeAsyncableMethod(lcons, "buildOverviews", buildOverviews);
+  Nan__SetPrototypeAsyncableMethod(lcons, "adviseRead", adviseRead);
+  Nan__SetPrototypeAsyncableMethod(lcons, "render", render);
 
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
   ATTR(lcons, "description", descriptionGetter, READ_ONLY_SETTER);
@@ -51,10 +63,36 @@ void Dataset::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-Dataset::Dataset(GDALDataset *ds) : Nan::ObjectWrap(), uid(0), parent_uid(0), this_dataset(ds), parent_ds(nullptr) {
+Dataset::Dataset(GDALDataset *ds)
+  : Nan::ObjectWrap(),
+    uid(0),
+    parent_uid(0),
+    snapshot(),
+    generation(std::make_shared<std::atomic<long>>(0)),
+    this_dataset(ds),
+    parent_ds(nullptr) {
   LOG("Created Dataset [%p]", ds);
 }
 
+void Dataset::takeSnapshot(GDALDataset *ds, Snapshot &snapshot) {
+  snapshot.valid = false;
+  if (ds == nullptr || ds->GetAccess() != GA_ReadOnly) return;
+
+  // GDAL 2.x will return 512x512 for vector datasets, see rasterSizeGetter
+  snapshot.raster = ds->GetDriver() != nullptr && ds->GetDriver()->GetMetadataItem(GDAL_DCAP_RASTER) != nullptr;
+  snapshot.x = ds->GetRasterXSize();
+  snapshot.y = ds->GetRasterYSize();
+  snapshot.band_count = ds->GetRasterCount();
+  snapshot.has_geotransform = ds->GetGeoTransform(snapshot.geotransform) == CE_None;
+  const char *wkt = ds->GetProjectionRef();
+  snapshot.wkt = wkt != nullptr ? wkt : "";
+  snapshot.has_nodata.resize(snapshot.band_count);
+  snapshot.nodata.resize(snapshot.band_count);
+  for (int i = 0; i < snapshot.band_count; i++)
+    snapshot.nodata[i] = ds->GetRasterBand(i + 1)->GetNoDataValue(&snapshot.has_nodata[i]);
+  snapshot.valid = true;
+}
+
 Dataset::~Dataset() {
   // Destroy at garbage collection time if not already explicitly destroyed
   dispose(false);
@@ -70,6 +108,7 @@ void Dataset::dispose(bool manual) {
 
     this_dataset = NULL;
   }
+  pinned.Reset();
 }
 
 /**
@@ -126,7 +165,7 @@ NAN_METHOD(Dataset::New) {
   }
 }
 
-Local<Value> Dataset::New(GDALDataset *raw, GDALDataset *parent) {
+Local<Value> Dataset::New(GDALDataset *raw, GDALDataset *parent, const Snapshot *snapshot) {
   Nan::EscapableHandleScope scope;
 
   if (!raw) { return scope.Escape(Nan::Null()); }
@@ -147,6 +186,12 @@ Local<Value> Dataset::New(GDALDataset *raw, GDALDataset *parent) {
     Nan::NewInstance(Nan::GetFunction(Nan::New(Dataset::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
 
   wrapped->uid = object_store.add(raw, wrapped->persistent(), parent_uid);
+  // A newly opened Dataset cannot be used by another thread yet
+  // A dependent Dataset shares the lock of its parent which can be held by an async job
+  if (snapshot != nullptr)
+    wrapped->snapshot = *snapshot;
+  else if (parent == nullptr)
+    takeSnapshot(raw, wrapped->snapshot);
 
   return scope.Escape(obj);
 }
@@ -155,6 +200,114 @@ NAN_METHOD(Dataset::toString) {
   info.GetReturnValue().Set(Nan::New("Dataset").ToLocalChecked());
 }
 
+/**
+ * @typedef {object} TypedArraysOptions
+ * @property {number} width
+ * @property {number} height
+ * @property {TypedArray[]} bands The pixels of each band, row by row, the data type of a band is the type of its array
+ * @property {number[]} [geoTransform]
+ * @property {SpatialReference} [srs]
+ */
+
+/**
+ * Creates an in-memory `MEM` dataset whose bands are the given `TypedArray`s.
+ *
+ * The pixels are not copied, the dataset reads and writes directly the memory
+ * of the arrays. The arrays are referenced by the dataset until it is closed,
+ * they must not be transferred to a worker thread while it is open.
+ *
+ * @example
+ * const ds = gdal.Dataset.fromTypedArrays({
+ *   width: 256, height: 256,
+ *   bands: [ new Float32Array(256 * 256) ],
+ *   geoTransform: [ 0, 1, 0, 256, 0, -1 ],
+ *   srs: gdal.SpatialReference.fromEPSG(3857)
+ * })
+ * await gdal.polygonizeAsync({ src: ds.bands.get(1), dst: layer, pixValField: 0 })
+ *
+ * @static
+ * @throws {Error}
+ * @method fromTypedArrays
+ * @memberof Dataset
+ * @param {TypedArraysOptions} options
+ * @return {Dataset}
+ */
+NAN_METHOD(Dataset::fromTypedArrays) {
+  Local<Object> options;
+  NODE_ARG_OBJECT(0, "options", options);
+  int width = 0, height = 0;
+  Local<Array> bands;
+  NODE_INT_FROM_OBJ(options, "width", width);
+  NODE_INT_FROM_OBJ(options, "height", height);
+  NODE_ARRAY_FROM_OBJ(options, "bands", bands);
+  if (width <= 0 || height <= 0) {
+    Nan::ThrowRangeError("width and height must be positive");
+    return;
+  }
+  if (bands->Length() == 0) {
+    Nan::ThrowError("bands must contain at least one array");
+    return;
+  }
+
+  Local<Array> arrays = Nan::New<Array>(bands->Length());
+  std::vector<GDALDataType> types;
+  std::vector<void *> buffers;
+  for (unsigned i = 0; i < bands->Length(); i++) {
+    Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
+    if (!val->IsObject()) {
+      Nan::ThrowTypeError("bands must contain only TypedArrays");
+      return;
+    }
+    GDALDataType type = TypedArray::Identify(val.As<Object>());
+    void *data = TypedArray::Validate(val.As<Object>(), type, static_cast<int64_t>(width) * height);
+    if (data == nullptr) return;
+    Nan::Set(arrays, i, val);
+    types.push_back(type);
+    buffers.push_back(data);
+  }
+
+  GDALDriver *driver = GetGDALDriverManager()->GetDriverByName("MEM");
+  if (driver == nullptr) {
+    Nan::ThrowError("MEM driver is not available");
+    return;
+  }
+  CPLErrorReset();
+  GDALDataset *raw = driver->Create("", width, height, 0, GDT_Byte, nullptr);
+  if (raw == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+  for (size_t i = 0; i < buffers.size(); i++) {
+    char pointer[64];
+    pointer[CPLPrintPointer(pointer, buffers[i], sizeof(pointer) - 1)] = 0;
+    std::string option = std::string("DATAPOINTER=") + pointer;
+    char *band_options[] = {const_cast<char *>(option.c_str()), nullptr};
+    if (raw->AddBand(types[i], band_options) != CE_None) {
+      GDALClose(raw);
+      NODE_THROW_LAST_CPLERR;
+      return;
+    }
+  }
+
+  Local<Value> obj = Dataset::New(raw);
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(obj.As<Object>());
+  ds->pinned.Reset(arrays);
+
+  // The setters validate the values
+  static const char *const properties[] = {"geoTransform", "srs"};
+  for (const char *property : properties) {
+    Local<String> sym = Nan::New(property).ToLocalChecked();
+    Local<Value> val = Nan::Get(options, sym).ToLocalChecked();
+    if (val->IsUndefined() || val->IsNull()) continue;
+    if (Nan::Set(obj.As<Object>(), sym, val).IsNothing()) {
+      ds->dispose(true);
+      return;
+    }
+  }
+
+  info.GetReturnValue().Set(obj);
+}
+
 /**
  * Fetch metadata.
  *
@@ -237,6 +390,275 @@ GDAL_ASYNCABLE_DEFINE(Dataset::setMetadata) {
   job.run(info, async, 2);
 }
 
+/**
+ * @typedef {object} DescribeOptions
+ * @property {boolean} [bands=true] include the bands
+ * @property {boolean} [overviews=false] include the sizes of the overviews of each band
+ * @property {boolean} [metadata=false] include the metadata of the default domain
+ */
+
+/**
+ * @typedef {object} BandDescription
+ * @property {number} id
+ * @property {string} description
+ * @property {xyz} size
+ * @property {xyz} blockSize
+ * @property {string|null} dataType
+ * @property {number|null} noDataValue
+ * @property {string|undefined} colorInterpretation
+ * @property {string} unitType
+ * @property {number|null} scale
+ * @property {number|null} offset
+ * @property {number} overviewCount
+ * @property {xyz[]} [overviews]
+ * @property {any} [metadata]
+ */
+
+/**
+ * @typedef {object} DatasetDescription
+ * @property {string} description
+ * @property {string|null} driver
+ * @property {xyz|null} rasterSize
+ * @property {SpatialReference|null} srs
+ * @property {number[]|null} geoTransform
+ * @property {number} bandCount
+ * @property {number} layerCount
+ * @property {BandDescription[]} [bands]
+ * @property {any} [metadata]
+ */
+
+struct BandDescription {
+  int id;
+  std::string description;
+  int x, y, block_x, block_y;
+  GDALDataType type;
+  int has_nodata, has_scale, has_offset;
+  double nodata, scale, offset;
+  GDALColorInterp ci;
+  std::string unit;
+  int overview_count;
+  std::vector<std::pair<int, int>> overviews;
+  char **metadata;
+
+  BandDescription() : metadata(nullptr) {
+  }
+  ~BandDescription() {
+    CSLDestroy(metadata);
+  }
+  BandDescription(const BandDescription &) = delete;
+};
+
+struct DatasetDescription {
+  std::string description, driver, wkt;
+  bool raster, has_geotransform;
+  int x, y, band_count, layer_count;
+  double geotransform[6];
+  std::vector<std::unique_ptr<BandDescription>> bands;
+  char **metadata;
+
+  DatasetDescription() : metadata(nullptr) {
+  }
+  ~DatasetDescription() {
+    CSLDestroy(metadata);
+  }
+  DatasetDescription(const DatasetDescription &) = delete;
+};
+
+static inline Local<Object> xyObject(int x, int y) {
+  Local<Object> r = Nan::New<Object>();
+  Nan::Set(r, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(x));
+  Nan::Set(r, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(y));
+  return r;
+}
+
+static inline Local<Value> maybeNumber(int success, double value) {
+  if (success) return Nan::New<Number>(value);
+  return Nan::Null();
+}
+
+/**
+ * Retrieves the properties of the dataset and its bands.
+ *
+ * Collects in a single operation the values of `rasterSize`, `srs`, `geoTransform`
+ * and the size, block size, data type, no data value, color interpretation, unit type,
+ * scale, offset and overviews of every band, acquiring the Dataset lock only once.
+ *
+ * @method describe
+ * @instance
+ * @memberof Dataset
+ * @param {DescribeOptions} [options]
+ * @param {boolean} [options.bands=true]
+ * @param {boolean} [options.overviews=false]
+ * @param {boolean} [options.metadata=false]
+ * @return {DatasetDescription}
+ */
+
+/**
+ * Retrieves the properties of the dataset and its bands.
+ * @async
+ *
+ * Collects in a single operation the values of `rasterSize`, `srs`, `geoTransform`
+ * and the size, block size, data type, no data value, color interpretation, unit type,
+ * scale, offset and overviews of every band, acquiring the Dataset lock only once.
+ *
+ * @method describeAsync
+ * @instance
+ * @memberof Dataset
+ * @param {DescribeOptions} [options]
+ * @param {boolean} [options.bands=true]
+ * @param {boolean} [options.overviews=false]
+ * @param {boolean} [options.metadata=false]
+ * @param {callback<DatasetDescription>} [callback=undefined]
+ * @return {Promise<DatasetDescription>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::describe) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  Local<Object> options;
+  bool with_bands = true, with_overviews = false, with_metadata = false;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_BOOL_FROM_OBJ_OPT(options, "bands", with_bands);
+    NODE_BOOL_FROM_OBJ_OPT(options, "overviews", with_overviews);
+    NODE_BOOL_FROM_OBJ_OPT(options, "metadata", with_metadata);
+  }
+
+  GDALAsyncableJob<std::shared_ptr<DatasetDescription>> job(ds->uid);
+  job.main = [raw, with_bands, with_overviews, with_metadata](const GDALExecutionProgress &) {
+    auto r = std::make_shared<DatasetDescription>();
+    const char *str;
+
+    CPLErrorReset();
+    str = raw->GetDescription();
+    r->description = str != nullptr ? str : "";
+    GDALDriver *driver = raw->GetDriver();
+    r->driver = driver != nullptr ? driver->GetDescription() : "";
+    // GDAL 2.x will return 512x512 for vector datasets
+    r->raster = driver != nullptr && driver->GetMetadataItem(GDAL_DCAP_RASTER) != nullptr;
+    r->x = raw->GetRasterXSize();
+    r->y = raw->GetRasterYSize();
+    r->has_geotransform = raw->GetGeoTransform(r->geotransform) == CE_None;
+    str = raw->GetProjectionRef();
+    r->wkt = str != nullptr ? str : "";
+    r->band_count = raw->GetRasterCount();
+    r->layer_count = raw->GetLayerCount();
+    if (with_metadata) r->metadata = CSLDuplicate(raw->GetMetadata());
+
+    if (!with_bands) return r;
+    for (int i = 1; i <= r->band_count; i++) {
+      GDALRasterBand *band = raw->GetRasterBand(i);
+      if (band == nullptr) throw CPLGetLastErrorMsg();
+      auto b = std::unique_ptr<BandDescription>(new BandDescription);
+      b->id = i;
+      str = band->GetDescription();
+      b->description = str != nullptr ? str : "";
+      b->x = band->GetXSize();
+      b->y = band->GetYSize();
+      band->GetBlockSize(&b->block_x, &b->block_y);
+      b->type = band->GetRasterDataType();
+      b->nodata = band->GetNoDataValue(&b->has_nodata);
+      b->scale = band->GetScale(&b->has_scale);
+      b->offset = band->GetOffset(&b->has_offset);
+      b->ci = band->GetColorInterpretation();
+      str = band->GetUnitType();
+      b->unit = str != nullptr ? str : "";
+      b->overview_count = band->GetOverviewCount();
+      if (with_overviews) {
+        for (int j = 0; j < b->overview_count; j++) {
+          GDALRasterBand *overview = band->GetOverview(j);
+          if (overview == nullptr) continue;
+          b->overviews.push_back(std::make_pair(overview->GetXSize(), overview->GetYSize()));
+        }
+      }
+      if (with_metadata) b->metadata = CSLDuplicate(band->GetMetadata());
+      r->bands.push_back(std::move(b));
+    }
+    return r;
+  };
+
+  job.rval = [with_bands, with_overviews, with_metadata](
+               std::shared_ptr<DatasetDescription> r, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+
+    Nan::Set(result, Nan::New("description").ToLocalChecked(), SafeString::New(r->description.c_str()));
+    if (r->driver.empty())
+      Nan::Set(result, Nan::New("driver").ToLocalChecked(), Nan::Null());
+    else
+      Nan::Set(result, Nan::New("driver").ToLocalChecked(), SafeString::New(r->driver.c_str()));
+
+    if (r->raster)
+      Nan::Set(result, Nan::New("rasterSize").ToLocalChecked(), xyObject(r->x, r->y));
+    else
+      Nan::Set(result, Nan::New("rasterSize").ToLocalChecked(), Nan::Null());
+
+    Local<Value> srs = Nan::Null();
+    if (!r->wkt.empty()) {
+      OGRChar *wkt = (OGRChar *)r->wkt.c_str();
+      OGRSpatialReference *ogr_srs = new OGRSpatialReference();
+      if (ogr_srs->importFromWkt(&wkt) == OGRERR_NONE)
+        srs = SpatialReference::New(ogr_srs, true);
+      else
+        delete ogr_srs;
+    }
+    Nan::Set(result, Nan::New("srs").ToLocalChecked(), srs);
+
+    if (r->has_geotransform) {
+      Local<Array> gt = Nan::New<Array>(6);
+      for (int i = 0; i < 6; i++) Nan::Set(gt, i, Nan::New<Number>(r->geotransform[i]));
+      Nan::Set(result, Nan::New("geoTransform").ToLocalChecked(), gt);
+    } else {
+      Nan::Set(result, Nan::New("geoTransform").ToLocalChecked(), Nan::Null());
+    }
+
+    Nan::Set(result, Nan::New("bandCount").ToLocalChecked(), Nan::New<Integer>(r->band_count));
+    Nan::Set(result, Nan::New("layerCount").ToLocalChecked(), Nan::New<Integer>(r->layer_count));
+    if (with_metadata) Nan::Set(result, Nan::New("metadata").ToLocalChecked(), MajorObject::getMetadata(r->metadata));
+
+    if (with_bands) {
+      Local<Array> bands = Nan::New<Array>(r->bands.size());
+      for (size_t i = 0; i < r->bands.size(); i++) {
+        const BandDescription *b = r->bands[i].get();
+        Local<Object> band = Nan::New<Object>();
+        Nan::Set(band, Nan::New("id").ToLocalChecked(), Nan::New<Integer>(b->id));
+        Nan::Set(band, Nan::New("description").ToLocalChecked(), SafeString::New(b->description.c_str()));
+        Nan::Set(band, Nan::New("size").ToLocalChecked(), xyObject(b->x, b->y));
+        Nan::Set(band, Nan::New("blockSize").ToLocalChecked(), xyObject(b->block_x, b->block_y));
+        if (b->type == GDT_Unknown)
+          Nan::Set(band, Nan::New("dataType").ToLocalChecked(), Nan::Null());
+        else
+          Nan::Set(band, Nan::New("dataType").ToLocalChecked(), SafeString::New(GDALGetDataTypeName(b->type)));
+        Nan::Set(band, Nan::New("noDataValue").ToLocalChecked(), maybeNumber(b->has_nodata, b->nodata));
+        if (b->ci == GCI_Undefined)
+          Nan::Set(band, Nan::New("colorInterpretation").ToLocalChecked(), Nan::Undefined());
+        else
+          Nan::Set(
+            band,
+            Nan::New("colorInterpretation").ToLocalChecked(),
+            SafeString::New(GDALGetColorInterpretationName(b->ci)));
+        Nan::Set(band, Nan::New("unitType").ToLocalChecked(), SafeString::New(b->unit.c_str()));
+        Nan::Set(band, Nan::New("scale").ToLocalChecked(), maybeNumber(b->has_scale, b->scale));
+        Nan::Set(band, Nan::New("offset").ToLocalChecked(), maybeNumber(b->has_offset, b->offset));
+        Nan::Set(band, Nan::New("overviewCount").ToLocalChecked(), Nan::New<Integer>(b->overview_count));
+        if (with_overviews) {
+          Local<Array> overviews = Nan::New<Array>(b->overviews.size());
+          for (size_t j = 0; j < b->overviews.size(); j++)
+            Nan::Set(overviews, j, xyObject(b->overviews[j].first, b->overviews[j].second));
+          Nan::Set(band, Nan::New("overviews").ToLocalChecked(), overviews);
+        }
+        if (with_metadata)
+          Nan::Set(band, Nan::New("metadata").ToLocalChecked(), MajorObject::getMetadata(b->metadata));
+        Nan::Set(bands, i, band);
+      }
+      Nan::Set(result, Nan::New("bands").ToLocalChecked(), bands);
+    }
+
+    return scope.Escape(result);
+  };
+  job.run(info, async, 1);
+}
+
 /**
  * Determines if the dataset supports the indicated operation.
  *
@@ -321,6 +743,9 @@ NAN_METHOD(Dataset::close) {
 /**
  * Flushes all changes to disk.
  *
+ * This also releases the blocks of all the bands of the dataset from the
+ * GDAL block cache, see `gdal.cache`.
+ *
  * @throws {Error}
  * @method flush
  * @instance
@@ -331,6 +756,9 @@ NAN_METHOD(Dataset::close) {
  * Flushes all changes to disk.
  * @async
  *
+ * This also releases the blocks of all the bands of the dataset from the
+ * GDAL block cache, see `gdal.cache`.
+ *
  * @method flushAsync
  * @instance
  * @memberof Dataset
@@ -409,9 +837,12 @@ GDAL_ASYNCABLE_DEFINE(Dataset::executeSQL) {
 
   GDALAsyncableJob<OGRLayer *> job(ds->uid);
   OGRGeometry *geom_filter = spatial_filter ? spatial_filter->get() : NULL;
-  job.main = [raw, sql, sql_dialect, geom_filter](const GDALExecutionProgress &) {
+  std::shared_ptr<std::atomic<long>> generation = ds->generation;
+  job.main = [raw, sql, sql_dialect, geom_filter, generation](const GDALExecutionProgress &) {
     CPLErrorReset();
     OGRLayer *layer = raw->ExecuteSQL(sql.c_str(), geom_filter, sql_dialect.empty() ? NULL : sql_dialect.c_str());
+    // The statement could have modified any layer
+    (*generation)++;
     if (layer == nullptr) throw CPLGetLastErrorMsg();
     return layer;
   };
@@ -420,6 +851,435 @@ GDAL_ASYNCABLE_DEFINE(Dataset::executeSQL) {
   job.run(info, async, 3);
 }
 
+/**
+ * Release the results of {@link Dataset.executeSQL} without waiting for the garbage collector.
+ *
+ * The layer cannot be used anymore after this call.
+ *
+ * @throws {Error}
+ * @method releaseResultSet
+ * @instance
+ * @memberof Dataset
+ * @param {Layer} layer SQL results layer returned by {@link Dataset.executeSQL}
+ */
+
+/**
+ * Release the results of {@link Dataset.executeSQL} without waiting for the garbage collector.
+ * @async
+ *
+ * The layer cannot be used anymore after this call.
+ *
+ * @throws {Error}
+ * @method releaseResultSetAsync
+ * @instance
+ * @memberof Dataset
+ * @param {Layer} layer SQL results layer returned by {@link Dataset.executeSQL}
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::releaseResultSet) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+
+  Layer *layer;
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  if (layer->parent_uid != ds->uid) {
+    Nan::ThrowError("Layer does not belong to this Dataset");
+    return;
+  }
+
+  long uid = layer->uid;
+  GDALAsyncableJob<int> job(ds->uid);
+  job.persist(layer->handle());
+  job.main = [uid](const GDALExecutionProgress &) {
+    if (!object_store.releaseResultSet(uid)) throw "Layer is not an SQL result set";
+    return 0;
+  };
+  job.rval = [](int, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
+/**
+ * @typedef {object} DatasetAdviseReadOptions
+ * @extends AdviseReadOptions
+ * @property {number[]} [bands] Bands that will be read, all bands by default
+ */
+
+/**
+ * Advises the driver that a window of several bands will be read soon.
+ *
+ * Drivers that support it (JP2OpenJPEG, ECW, some network-backed formats) can
+ * start fetching the data in the background or read it with fewer requests,
+ * the other drivers ignore it.
+ *
+ * @method adviseRead
+ * @instance
+ * @memberof Dataset
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {DatasetAdviseReadOptions} [options]
+ * @return {void}
+ */
+
+/**
+ * Advises the driver that a window of several bands will be read soon.
+ * @async
+ *
+ * Drivers that support it (JP2OpenJPEG, ECW, some network-backed formats) can
+ * start fetching the data in the background or read it with fewer requests,
+ * the other drivers ignore it.
+ *
+ * @method adviseReadAsync
+ * @instance
+ * @memberof Dataset
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {DatasetAdviseReadOptions} [options]
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::adviseRead) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  int x, y, w, h;
+  NODE_ARG_INT(0, "x", x);
+  NODE_ARG_INT(1, "y", y);
+  NODE_ARG_INT(2, "width", w);
+  NODE_ARG_INT(3, "height", h);
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(4, "options", options);
+  int buffer_w = w, buffer_h = h;
+  std::string type_name;
+  Local<Array> bands;
+  if (!options.IsEmpty()) {
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_width", buffer_w);
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_height", buffer_h);
+    NODE_STR_FROM_OBJ_OPT(options, "data_type", type_name);
+    NODE_ARRAY_FROM_OBJ_OPT(options, "bands", bands);
+  }
+  GDALDataType type = GDT_Unknown;
+  if (!type_name.empty()) {
+    type = GDALGetDataTypeByName(type_name.c_str());
+    if (type == GDT_Unknown) {
+      Nan::ThrowError("Invalid GDAL data type");
+      return;
+    }
+  }
+
+  std::vector<int> band_list;
+  if (!bands.IsEmpty()) {
+    for (unsigned i = 0; i < bands->Length(); i++) {
+      Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
+      if (!val->IsNumber()) {
+        Nan::ThrowError("band array must only contain numbers");
+        return;
+      }
+      band_list.push_back(Nan::To<int32_t>(val).ToChecked());
+    }
+  }
+
+  if (w <= 0 || h <= 0 || x < 0 || y < 0) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+  if (buffer_w <= 0 || buffer_h <= 0) {
+    Nan::ThrowRangeError("Invalid buffer size");
+    return;
+  }
+  // The raster size is checked without the lock only if it is immutable
+  if (ds->snapshot.valid && (x > ds->snapshot.x - w || y > ds->snapshot.y - h)) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+
+  GDALAsyncableJob<CPLErr> job(ds->uid);
+  job.main = [raw, x, y, w, h, buffer_w, buffer_h, type, band_list](const GDALExecutionProgress &) {
+    if (x > raw->GetRasterXSize() - w || y > raw->GetRasterYSize() - h) throw "Invalid window";
+    std::vector<int> list(band_list);
+    if (list.empty())
+      for (int i = 1; i <= raw->GetRasterCount(); i++) list.push_back(i);
+    if (list.empty()) return CE_None;
+    for (int b : list)
+      if (b < 1 || b > raw->GetRasterCount()) throw "Invalid band number";
+    GDALDataType buffer_type = type == GDT_Unknown ? raw->GetRasterBand(list[0])->GetRasterDataType() : type;
+    CPLErrorReset();
+    CPLErr err = raw->AdviseRead(
+      x, y, w, h, buffer_w, buffer_h, buffer_type, static_cast<int>(list.size()), list.data(), nullptr);
+    if (err) { throw CPLGetLastErrorMsg(); }
+    return err;
+  };
+  job.rval = [](CPLErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 5);
+}
+
+/**
+ * @typedef {object} RenderOptions
+ * @property {number[]} [bands] Bands to render, all bands (up to 4) by default
+ * @property {xyz} [outSize] Size of the image, the size of the window by default
+ * @property {string} [format="PNG"] Short name of the GDAL driver encoding the image, `PNG`, `JPEG`, `WEBP`...
+ * @property {StringOptions} [creationOptions] Creation options of the driver
+ * @property {ColorTable} [colorTable] Palette expanding a single band to RGB or RGBA (if it has transparent entries)
+ * @property {number[]|number[][]} [scale] `[min, max]` range mapped to 0..255, for all bands or one range per band
+ * @property {string} [resampling] Resampling algorithm when `outSize` is not the size of the window
+ */
+
+struct RenderedImage {
+  GByte *data;
+  vsi_l_offset size;
+};
+
+/**
+ * Renders a window of the dataset to an encoded image (PNG, JPEG, WebP...)
+ * in a single operation.
+ *
+ * The pixels are read, optionally scaled or expanded through a palette to 8-bit
+ * values and encoded in memory without any intermediate dataset or file.
+ * Without `scale`, the values outside of 0..255 are clamped.
+ *
+ * @example
+ * const png = ds.render({ x: 0, y: 0, width: 512, height: 512 },
+ *   { bands: [ 1 ], outSize: { x: 256, y: 256 }, scale: [ 0, 3000 ], resampling: 'Average' })
+ * res.type('png').send(png)
+ *
+ * @throws {Error}
+ * @method render
+ * @instance
+ * @memberof Dataset
+ * @param {VRTWindow} window
+ * @param {RenderOptions} [options]
+ * @return {Buffer}
+ */
+
+/**
+ * Renders a window of the dataset to an encoded image (PNG, JPEG, WebP...)
+ * in a single operation.
+ * @async
+ *
+ * The pixels are read, optionally scaled or expanded through a palette to 8-bit
+ * values and encoded in memory without any intermediate dataset or file.
+ *
+ * @throws {Error}
+ * @method renderAsync
+ * @instance
+ * @memberof Dataset
+ * @param {VRTWindow} window
+ * @param {RenderOptions} [options]
+ * @param {callback<Buffer>} [callback=undefined]
+ * @return {Promise<Buffer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::render) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  Local<Object> window;
+  NODE_ARG_OBJECT(0, "window", window);
+  int x, y, w, h;
+  NODE_INT_FROM_OBJ(window, "x", x);
+  NODE_INT_FROM_OBJ(window, "y", y);
+  NODE_INT_FROM_OBJ(window, "width", w);
+  NODE_INT_FROM_OBJ(window, "height", h);
+  if (x < 0 || y < 0 || w <= 0 || h <= 0) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  int out_w = w, out_h = h;
+  std::string format = "PNG";
+  Local<Array> bands, scale_array;
+  ColorTable *color_table = nullptr;
+  std::shared_ptr<StringList> creation_options = std::make_shared<StringList>();
+  GDALRIOResampleAlg resampling = GRIORA_NearestNeighbour;
+  if (!options.IsEmpty()) {
+    NODE_ARRAY_FROM_OBJ_OPT(options, "bands", bands);
+    NODE_STR_FROM_OBJ_OPT(options, "format", format);
+    NODE_ARRAY_FROM_OBJ_OPT(options, "scale", scale_array);
+    NODE_WRAPPED_FROM_OBJ_OPT(options, "colorTable", ColorTable, color_table);
+    Local<Value> size = Nan::Get(options, Nan::New("outSize").ToLocalChecked()).ToLocalChecked();
+    if (size->IsObject()) {
+      NODE_INT_FROM_OBJ(size.As<Object>(), "x", out_w);
+      NODE_INT_FROM_OBJ(size.As<Object>(), "y", out_h);
+    } else if (!size->IsUndefined() && !size->IsNull()) {
+      Nan::ThrowTypeError("outSize must be an object with x and y");
+      return;
+    }
+    if (creation_options->parse(Nan::Get(options, Nan::New("creationOptions").ToLocalChecked()).ToLocalChecked())) {
+      return; // error parsing creation options, NAN error already thrown
+    }
+    try {
+      resampling = parseResamplingAlg(Nan::Get(options, Nan::New("resampling").ToLocalChecked()).ToLocalChecked());
+    } catch (const char *e) {
+      Nan::ThrowError(e);
+      return;
+    }
+  }
+  if (out_w <= 0 || out_h <= 0) {
+    Nan::ThrowRangeError("Invalid outSize");
+    return;
+  }
+
+  std::vector<int> band_list;
+  if (!bands.IsEmpty()) {
+    for (unsigned i = 0; i < bands->Length(); i++) {
+      Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
+      if (!val->IsNumber()) {
+        Nan::ThrowError("band array must only contain numbers");
+        return;
+      }
+      band_list.push_back(Nan::To<int32_t>(val).ToChecked());
+    }
+  }
+
+  // [min, max] or [[min, max], ...]
+  std::vector<std::array<double, 2>> scale;
+  if (!scale_array.IsEmpty() && scale_array->Length() > 0) {
+    bool single = Nan::Get(scale_array, 0).ToLocalChecked()->IsNumber();
+    for (unsigned i = 0; i < (single ? 1 : scale_array->Length()); i++) {
+      Local<Value> range = single ? scale_array.As<Value>() : Nan::Get(scale_array, i).ToLocalChecked();
+      if (!range->IsArray() || range.As<Array>()->Length() != 2) {
+        Nan::ThrowError("scale must be a [min, max] range or an array of ranges");
+        return;
+      }
+      std::array<double, 2> r;
+      for (unsigned j = 0; j < 2; j++) {
+        Local<Value> val = Nan::Get(range.As<Array>(), j).ToLocalChecked();
+        if (!val->IsNumber()) {
+          Nan::ThrowError("scale must be a [min, max] range or an array of ranges");
+          return;
+        }
+        r[j] = Nan::To<double>(val).ToChecked();
+      }
+      scale.push_back(r);
+    }
+  }
+
+  GDALDriver *driver = GetGDALDriverManager()->GetDriverByName(format.c_str());
+  if (driver == nullptr ||
+      (driver->GetMetadataItem(GDAL_DCAP_CREATECOPY) == nullptr &&
+       driver->GetMetadataItem(GDAL_DCAP_CREATE) == nullptr)) {
+    Nan::ThrowError("format must be a driver supporting CreateCopy");
+    return;
+  }
+  bool jpeg = EQUAL(format.c_str(), "JPEG");
+
+  std::shared_ptr<GDALColorTable> ct;
+  if (color_table) ct = std::shared_ptr<GDALColorTable>(color_table->get()->Clone());
+
+  GDALAsyncableJob<RenderedImage> job(ds->uid);
+  job.main = [raw, x, y, w, h, out_w, out_h, band_list, scale, ct, jpeg, driver, creation_options, resampling](
+               const GDALExecutionProgress &) {
+    std::vector<int> list(band_list);
+    if (list.empty())
+      for (int i = 1; i <= std::min(raw->GetRasterCount(), 4); i++) list.push_back(i);
+    if (list.empty()) throw "Dataset has no raster bands";
+    for (int b : list)
+      if (b < 1 || b > raw->GetRasterCount()) throw "Invalid band number";
+    if (ct && list.size() != 1) throw "colorTable requires a single band";
+    if (scale.size() > 1 && scale.size() != list.size()) throw "scale must have one range per band";
+
+    const size_t pixels = static_cast<size_t>(out_w) * out_h;
+    std::vector<GByte> bytes(pixels * list.size());
+    GDALRasterIOExtraArg extra;
+    INIT_RASTERIO_EXTRA_ARG(extra);
+    extra.eResampleAlg = resampling;
+    CPLErrorReset();
+    if (scale.empty()) {
+      if (raw->RasterIO(
+            GF_Read,
+            x,
+            y,
+            w,
+            h,
+            bytes.data(),
+            out_w,
+            out_h,
+            GDT_Byte,
+            static_cast<int>(list.size()),
+            list.data(),
+            0,
+            0,
+            0,
+            &extra) != CE_None)
+        throw CPLGetLastErrorMsg();
+    } else {
+      std::vector<double> values(pixels);
+      for (size_t b = 0; b < list.size(); b++) {
+        GDALRasterBand *band = raw->GetRasterBand(list[b]);
+        if (band->RasterIO(GF_Read, x, y, w, h, values.data(), out_w, out_h, GDT_Float64, 0, 0, &extra) != CE_None)
+          throw CPLGetLastErrorMsg();
+        const std::array<double, 2> &range = scale[scale.size() == 1 ? 0 : b];
+        double factor = range[1] != range[0] ? 255 / (range[1] - range[0]) : 0;
+        GByte *dst = &bytes[b * pixels];
+        for (size_t i = 0; i < pixels; i++) {
+          double v = (values[i] - range[0]) * factor;
+          dst[i] = !(v > 0) ? 0 : v >= 255 ? 255 : static_cast<GByte>(v + 0.5);
+        }
+      }
+    }
+
+    int out_bands = static_cast<int>(list.size());
+    if (ct) {
+      const int count = ct->GetColorEntryCount();
+      bool alpha = false;
+      for (int i = 0; i < count && !jpeg; i++)
+        if (ct->GetColorEntry(i)->c4 != 255) alpha = true;
+      out_bands = alpha ? 4 : 3;
+      std::vector<GByte> expanded(pixels * out_bands);
+      for (size_t i = 0; i < pixels; i++) {
+        const GDALColorEntry *e = bytes[i] < count ? ct->GetColorEntry(bytes[i]) : nullptr;
+        const short components[] = {e ? e->c1 : 0, e ? e->c2 : 0, e ? e->c3 : 0, e ? e->c4 : 0};
+        for (int c = 0; c < out_bands; c++) expanded[c * pixels + i] = static_cast<GByte>(components[c]);
+      }
+      bytes.swap(expanded);
+    }
+
+    // The MEM dataset uses the buffer without copying it
+    GDALDriver *mem = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (mem == nullptr) throw "MEM driver is not available";
+    // GDALDatasetUniquePtr requires GDAL 2.3
+    auto close = [](GDALDataset *ds) { GDALClose(ds); };
+    std::unique_ptr<GDALDataset, decltype(close)> src(mem->Create("", out_w, out_h, 0, GDT_Byte, nullptr), close);
+    if (!src) throw CPLGetLastErrorMsg();
+    for (int b = 0; b < out_bands; b++) {
+      char pointer[64];
+      pointer[CPLPrintPointer(pointer, &bytes[b * pixels], sizeof(pointer) - 1)] = 0;
+      std::string option = std::string("DATAPOINTER=") + pointer;
+      char *band_options[] = {const_cast<char *>(option.c_str()), nullptr};
+      if (src->AddBand(GDT_Byte, band_options) != CE_None) throw CPLGetLastErrorMsg();
+    }
+
+    static std::atomic<long> counter(0);
+    std::string path = CPLSPrintf("/vsimem/_node_gdal_render_%ld", counter++);
+    std::unique_ptr<GDALDataset, decltype(close)> dst(
+      driver->CreateCopy(path.c_str(), src.get(), FALSE, creation_options->get(), nullptr, nullptr), close);
+    if (!dst) {
+      VSIUnlink(path.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    dst.reset();
+    VSIUnlink((path + ".aux.xml").c_str());
+    RenderedImage image;
+    image.data = VSIGetMemFileBuffer(path.c_str(), &image.size, TRUE);
+    if (image.data == nullptr) throw "Failed encoding the image";
+    return image;
+  };
+  job.rval = [](RenderedImage image, const GetFromPersistentFunc &) {
+    return Nan::NewBuffer(
+             reinterpret_cast<char *>(image.data),
+             static_cast<size_t>(image.size),
+             [](char *data, void *) { VSIFree(data); },
+             nullptr)
+      .ToLocalChecked()
+      .As<Value>();
+  };
+  job.run(info, async, 2);
+}
+
 /**
  * Fetch files forming dataset.
  *
@@ -468,6 +1328,71 @@ NAN_METHOD(Dataset::getFileList) {
   info.GetReturnValue().Set(results);
 }
 
+/**
+ * @typedef {object} IOStats
+ * @memberof Dataset
+ * @property {number} bytesRead Bytes read from the files of the dataset
+ * @property {number} reads Number of read calls
+ * @property {number} seeks Number of seeks that moved the file pointer
+ * @property {number} bytesWritten Bytes written to the files of the dataset
+ * @property {number} writes Number of write calls
+ * @property {number} blockDecodes Estimated number of raster blocks that were not in the block cache
+ * @property {number} cacheHits Estimated number of raster blocks found in the block cache
+ */
+
+/**
+ * Returns the I/O statistics of a dataset opened with the `"s"` mode.
+ *
+ * The file operations are counted on the main file of the dataset and on all the
+ * side-car files found by the driver (overviews, `.aux.xml`...), allowing to measure
+ * the read amplification of a given request. The block decodes and the cache hits
+ * are counted for the `RasterBandPixels` read/write methods.
+ *
+ * The multi-range reads (COG on `/vsicurl/`) are forwarded to the real file and each
+ * one counts as a single read. The driver sees the file as
+ * `/vsiiostats/<id>/<path>`, this is the path returned by `description` and
+ * `getFileList()`. Requires GDAL 3.0.
+ *
+ * @example
+ *
+ * const ds = gdal.open('/vsicurl/https://example.com/cog.tif', 'rs')
+ * await ds.bands.get(1).pixels.readAsync(0, 0, 256, 256)
+ * console.log(ds.ioStats(true))
+ *
+ * @method ioStats
+ * @instance
+ * @memberof Dataset
+ * @param {boolean} [reset=false] Reset the counters after reading them
+ * @throws {Error}
+ * @return {IOStats}
+ */
+NAN_METHOD(Dataset::ioStats) {
+  bool reset = false;
+  NODE_ARG_BOOL_OPT(0, "reset", reset);
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  std::shared_ptr<IOStats> stats = IOStats::get(raw);
+  if (stats == nullptr) {
+    Nan::ThrowError("I/O statistics are available only for datasets opened with the \"s\" mode");
+    return;
+  }
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("bytesRead").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->bytes_read)));
+  Nan::Set(result, Nan::New("reads").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->reads)));
+  Nan::Set(result, Nan::New("seeks").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->seeks)));
+  Nan::Set(
+    result, Nan::New("bytesWritten").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->bytes_written)));
+  Nan::Set(result, Nan::New("writes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->writes)));
+  Nan::Set(
+    result, Nan::New("blockDecodes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->block_decodes)));
+  Nan::Set(result, Nan::New("cacheHits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(stats->cache_hits)));
+  if (reset) stats->reset();
+
+  info.GetReturnValue().Set(result);
+}
+
 /**
  * Fetches GCPs.
  *
@@ -583,6 +1508,89 @@ NAN_METHOD(Dataset::setGCPs) {
   return;
 }
 
+// Reports the progress of one step of a multi-step operation
+// as the overall progress with the message of the step
+struct StepProgress {
+  GDALProgressFunc progress;
+  void *progress_arg;
+  double from, to;
+  std::string message;
+};
+
+static int CPL_STDCALL StepProgressFunc(double complete, const char *, void *arg) {
+  StepProgress *step = static_cast<StepProgress *>(arg);
+  return step->progress(step->from + complete * (step->to - step->from), step->message.c_str(), step->progress_arg);
+}
+
+static GDALRasterBand *findOverview(GDALRasterBand *band, int factor) {
+  for (int i = 0; i < band->GetOverviewCount(); i++) {
+    GDALRasterBand *overview = band->GetOverview(i);
+    if (overview == nullptr) continue;
+    if (GDALComputeOvFactor(overview->GetXSize(), band->GetXSize(), overview->GetYSize(), band->GetYSize()) == factor)
+      return overview;
+  }
+  return nullptr;
+}
+
+// Builds the overviews one level at a time, every level is computed from
+// the previous one instead of the full resolution band
+static CPLErr buildOverviewsCascade(
+  GDALDataset *ds,
+  const char *resampling,
+  int n_overviews,
+  int *overviews,
+  int n_bands,
+  int *bands,
+  GDALProgressFunc progress,
+  void *progress_arg) {
+  // Create all the levels without computing them
+  CPLErr err = ds->BuildOverviews("NONE", n_overviews, overviews, n_bands, bands, nullptr, nullptr);
+  if (err != CE_None) return err;
+
+  std::vector<int> levels(overviews, overviews + n_overviews);
+  std::sort(levels.begin(), levels.end());
+  std::vector<int> band_ids;
+  if (n_bands > 0)
+    band_ids.assign(bands, bands + n_bands);
+  else
+    for (int i = 1; i <= ds->GetRasterCount(); i++) band_ids.push_back(i);
+
+  double steps = static_cast<double>(levels.size() * band_ids.size());
+  int step = 0;
+  for (size_t level = 0; level < levels.size(); level++) {
+    for (int id : band_ids) {
+      GDALRasterBand *band = ds->GetRasterBand(id);
+      GDALRasterBand *src = level == 0 ? band : findOverview(band, levels[level - 1]);
+      GDALRasterBand *dst = findOverview(band, levels[level]);
+      if (src == nullptr || dst == nullptr) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Failed creating overview level %d", levels[level]);
+        return CE_Failure;
+      }
+      StepProgress step_progress = {
+        progress, progress_arg, step / steps, (step + 1) / steps, "overview level " + std::to_string(levels[level])};
+      err = GDALRegenerateOverviews(
+        src,
+        1,
+        reinterpret_cast<GDALRasterBandH *>(&dst),
+        resampling,
+        progress != nullptr ? StepProgressFunc : nullptr,
+        &step_progress);
+      if (err != CE_None) return err;
+      step++;
+    }
+  }
+  return CE_None;
+}
+
+/**
+ * @typedef {object} BuildOverviewsOptions
+ * @property {ProgressCb} [progress_cb]
+ * @property {number|string} [threads] Number of threads used to compute the overviews or `"ALL_CPUS"`,
+ * sets `GDAL_NUM_THREADS` only for this operation
+ * @property {boolean} [cascade] Compute every level from the previous one instead of the full
+ * resolution bands, the progress message is then the level being computed
+ */
+
 /**
  * Builds dataset overviews.
  *
@@ -594,8 +1602,10 @@ NAN_METHOD(Dataset::setGCPs) {
  * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
  * @param {number[]} overviews
  * @param {number[]} [bands] Note: Generation of overviews in external TIFF currently only supported when operating on all bands.
- * @param {ProgressOptions} [options] options
+ * @param {BuildOverviewsOptions} [options] options
  * @param {ProgressCb} [options.progress_cb]
+ * @param {number|string} [options.threads]
+ * @param {boolean} [options.cascade]
  */
 
 /**
@@ -610,8 +1620,10 @@ NAN_METHOD(Dataset::setGCPs) {
  * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
  * @param {number[]} overviews
  * @param {number[]} [bands] Note: Generation of overviews in external TIFF currently only supported when operating on all bands.
- * @param {ProgressOptions} [options] options
+ * @param {BuildOverviewsOptions} [options] options
  * @param {ProgressCb} [options.progress_cb]
+ * @param {number|string} [options.threads]
+ * @param {boolean} [options.cascade]
  * @param {callback<void>} [callback=undefined]
  * @return {Promise<void>}
  */
@@ -661,25 +1673,56 @@ GDAL_ASYNCABLE_DEFINE(Dataset::buildOverviews) {
   Nan::Callback *progress_cb;
   NODE_PROGRESS_CB_OPT(3, progress_cb, job);
   job.progress = progress_cb;
+
+  std::string threads;
+  bool cascade = false;
+  if (info.Length() > 3 && info[3]->IsObject()) {
+    Local<Object> options = info[3].As<Object>();
+    Local<String> sym = Nan::New("threads").ToLocalChecked();
+    if (Nan::HasOwnProperty(options, sym).FromMaybe(false)) {
+      Local<Value> val = Nan::Get(options, sym).ToLocalChecked();
+      if (val->IsNumber() && Nan::To<int32_t>(val).ToChecked() > 0) {
+        threads = std::to_string(Nan::To<int32_t>(val).ToChecked());
+      } else if (val->IsString() && std::string(*Nan::Utf8String(val)) == "ALL_CPUS") {
+        threads = "ALL_CPUS";
+      } else if (!val->IsUndefined()) {
+        Nan::ThrowRangeError("threads must be a positive integer or \"ALL_CPUS\"");
+        return;
+      }
+    }
+    NODE_BOOL_FROM_OBJ_OPT(options, "cascade", cascade);
+  }
   // Alas one cannot capture-move a unique_ptr and assign the lambda to a variable
   // because the lambda becomes non-copyable
   // But we can use a shared_ptr because the lifetime of the lambda is limited by the lifetime
   // of the async worker
-  job.main = [raw, resampling, n_overviews, o, n_bands, b, progress_cb](const GDALExecutionProgress &progress) {
+  job.main = [raw, resampling, n_overviews, o, n_bands, b, progress_cb, threads, cascade](
+               const GDALExecutionProgress &progress) {
     if (b != nullptr) {
       for (int i = 0; i < n_bands; i++) {
         if (b.get()[i] > raw->GetRasterCount() || b.get()[i] < 1) { throw "invalid band id"; }
       }
     }
+    // The configuration is thread-local, so it applies only to this job
+    ThreadLocalConfigOption num_threads("GDAL_NUM_THREADS", threads);
     CPLErrorReset();
-    CPLErr err = raw->BuildOverviews(
-      resampling.c_str(),
-      n_overviews,
-      o.get(),
-      n_bands,
-      b.get(),
-      progress_cb ? ProgressTrampoline : nullptr,
-      progress_cb ? (void *)&progress : nullptr);
+    CPLErr err = cascade ? buildOverviewsCascade(
+                             raw,
+                             resampling.c_str(),
+                             n_overviews,
+                             o.get(),
+                             n_bands,
+                             b.get(),
+                             progress_cb ? ProgressTrampoline : nullptr,
+                             progress_cb ? (void *)&progress : nullptr)
+                         : raw->BuildOverviews(
+                             resampling.c_str(),
+                             n_overviews,
+                             o.get(),
+                             n_bands,
+                             b.get(),
+                             progress_cb ? ProgressTrampoline : nullptr,
+                             progress_cb ? (void *)&progress : nullptr);
     if (err != CE_None) { throw CPLGetLastErrorMsg(); }
     return err;
   };
@@ -747,6 +1790,18 @@ GDAL_ASYNCABLE_GETTER_DEFINE(Dataset::rasterSizeGetter) {
     return;
   }
 
+  if (!async && ds->snapshot.valid) {
+    if (!ds->snapshot.raster) {
+      info.GetReturnValue().Set(Nan::Null());
+      return;
+    }
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(ds->snapshot.x));
+    Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(ds->snapshot.y));
+    info.GetReturnValue().Set(result);
+    return;
+  }
+
   GDALDataset *raw = ds->get();
 
   GDALAsyncableJob<xy> job(ds->uid);
@@ -809,6 +1864,23 @@ GDAL_ASYNCABLE_GETTER_DEFINE(Dataset::srsGetter) {
     return;
   }
 
+  if (!async && ds->snapshot.valid) {
+    if (ds->snapshot.wkt.empty()) {
+      info.GetReturnValue().Set(Nan::Null());
+      return;
+    }
+    OGRChar *wkt = (OGRChar *)ds->snapshot.wkt.c_str();
+    OGRSpatialReference *srs = new OGRSpatialReference();
+    int err = srs->importFromWkt(&wkt);
+    if (err) {
+      delete srs;
+      NODE_THROW_OGRERR(err);
+      return;
+    }
+    info.GetReturnValue().Set(SpatialReference::New(srs, true));
+    return;
+  }
+
   GDALDataset *raw = ds->get();
 
   GDALAsyncableJob<OGRSpatialReference *> job(ds->uid);
@@ -879,6 +1951,17 @@ GDAL_ASYNCABLE_GETTER_DEFINE(Dataset::geoTransformGetter) {
     return;
   }
 
+  if (!async && ds->snapshot.valid) {
+    if (!ds->snapshot.has_geotransform) {
+      info.GetReturnValue().Set(Nan::Null());
+      return;
+    }
+    Local<Array> result = Nan::New<Array>(6);
+    for (int i = 0; i < 6; i++) Nan::Set(result, i, Nan::New<Number>(ds->snapshot.geotransform[i]));
+    info.GetReturnValue().Set(result);
+    return;
+  }
+
   GDALDataset *raw = ds->get();
 
   GDALAsyncableJob<std::shared_ptr<double>> job(ds->uid);
@@ -982,7 +2065,12 @@ NAN_SETTER(Dataset::srsSetter) {
   AsyncGuard lock({ds->uid}, eventLoopWarn);
   CPLErr err = raw->SetProjection(wkt.c_str());
 
-  if (err) { NODE_THROW_LAST_CPLERR; }
+  if (err) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+  // Some drivers (PAM) allow this on read-only datasets
+  if (ds->snapshot.valid) ds->snapshot.wkt = wkt;
 }
 
 NAN_SETTER(Dataset::geoTransformSetter) {
@@ -1019,7 +2107,14 @@ NAN_SETTER(Dataset::geoTransformSetter) {
   AsyncGuard lock({ds->uid}, eventLoopWarn);
   CPLErr err = raw->SetGeoTransform(buffer);
 
-  if (err) { NODE_THROW_LAST_CPLERR; }
+  if (err) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+  if (ds->snapshot.valid) {
+    for (int i = 0; i < 6; i++) ds->snapshot.geotransform[i] = buffer[i];
+    ds->snapshot.has_geotransform = true;
+  }
 }
 
 /**
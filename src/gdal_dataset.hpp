@@ -16,6 +16,10 @@
 
 #include "async.hpp"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 using namespace v8;
 using namespace node;
 
@@ -30,18 +34,25 @@ class Dataset : public Nan::ObjectWrap {
   static Nan::Persistent<FunctionTemplate> constructor;
   static void Initialize(Local<Object> target);
   static NAN_METHOD(New);
-  static Local<Value> New(GDALDataset *ds, GDALDataset *parent = nullptr);
+  struct Snapshot;
+  static Local<Value> New(GDALDataset *ds, GDALDataset *parent = nullptr, const Snapshot *snapshot = nullptr);
   static NAN_METHOD(toString);
+  static NAN_METHOD(fromTypedArrays);
   GDAL_ASYNCABLE_DECLARE(flush);
   GDAL_ASYNCABLE_DECLARE(getMetadata);
   GDAL_ASYNCABLE_DECLARE(setMetadata);
+  GDAL_ASYNCABLE_DECLARE(describe);
   static NAN_METHOD(getFileList);
+  static NAN_METHOD(ioStats);
   static NAN_METHOD(getGCPProjection);
   static NAN_METHOD(getGCPs);
   static NAN_METHOD(setGCPs);
   GDAL_ASYNCABLE_DECLARE(executeSQL);
+  GDAL_ASYNCABLE_DECLARE(releaseResultSet);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(buildOverviews);
+  GDAL_ASYNCABLE_DECLARE(adviseRead);
+  GDAL_ASYNCABLE_DECLARE(render);
   static NAN_METHOD(close);
 
   static NAN_GETTER(bandsGetter);
@@ -67,6 +78,32 @@ class Dataset : public Nan::ObjectWrap {
   long uid;
   long parent_uid;
 
+  // Immutable properties of read-only datasets captured on open
+  // The sync getters return them without acquiring the Dataset lock
+  struct Snapshot {
+    bool valid;
+    bool raster;
+    int x, y;
+    int band_count;
+    bool has_geotransform;
+    double geotransform[6];
+    std::string wkt;
+    // The no data values of the bands, they can require I/O
+    std::vector<int> has_nodata;
+    std::vector<double> nodata;
+  } snapshot;
+  // This must be called only while no other thread can access the GDALDataset,
+  // usually by the job that opens it
+  static void takeSnapshot(GDALDataset *ds, Snapshot &snapshot);
+
+  // Incremented by every write operation on the layers,
+  // invalidates the cached extents and feature counts
+  std::shared_ptr<std::atomic<long>> generation;
+
+  // The TypedArrays holding the pixels of a dataset created by fromTypedArrays,
+  // released only after the GDALDataset has been closed
+  Nan::Persistent<Array> pinned;
+
   inline bool isAlive() {
     return this_dataset && object_store.isAlive(uid);
   }
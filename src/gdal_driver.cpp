@@ -461,17 +461,22 @@ GDAL_ASYNCABLE_DEFINE(Driver::open) {
 
   GDALDriver *raw = driver->getGDALDriver();
 
+  // The snapshot is taken by the worker, it may need I/O
+  auto snapshot = std::make_shared<Dataset::Snapshot>();
   GDALAsyncableJob<GDALDataset *> job(0);
   job.persist(driver->handle());
-  job.main = [raw, path, access, options](const GDALExecutionProgress &) {
+  job.main = [raw, path, access, options, snapshot](const GDALExecutionProgress &) {
     std::unique_ptr<StringList> options_ptr(options);
     const char *driver_list[2] = {raw->GetDescription(), nullptr};
     CPLErrorReset();
     GDALDataset *ds = (GDALDataset *)GDALOpenEx(path.c_str(), access, driver_list, options->get(), NULL);
     if (!ds) throw CPLGetLastErrorMsg();
+    Dataset::takeSnapshot(ds, *snapshot);
     return ds;
   };
-  job.rval = DatasetRval;
+  job.rval = [snapshot](GDALDataset *ds, const GetFromPersistentFunc &) {
+    return Dataset::New(ds, nullptr, snapshot.get());
+  };
 
   job.run(info, async, 2);
 }
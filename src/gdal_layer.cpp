@@ -25,10 +25,10 @@ void Layer::Initialize(Local<Object> target) {
   lcons->SetClassName(Nan::New("Layer").ToLocalChecked());
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
-  Nan::SetPrototypeMethod(lcons, "getExtent", getExtent);
-  Nan::SetPrototypeMethod(lcons, "setAttributeFilter", setAttributeFilter);
-  Nan::SetPrototypeMethod(lcons, "setSpatialFilter", setSpatialFilter);
-  Nan::SetPrototypeMethod(lcons, "getSpatialFilter", getSpatialFilter);
+  Nan__SetPrototypeAsyncableMethod(lcons, "getExtent", getExtent);
+  Nan__SetPrototypeAsyncableMethod(lcons, "setAttributeFilter", setAttributeFilter);
+  Nan__SetPrototypeAsyncableMethod(lcons, "setSpatialFilter", setSpatialFilter);
+  Nan__SetPrototypeAsyncableMethod(lcons, "getSpatialFilter", getSpatialFilter);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", syncToDisk);
 
@@ -47,6 +47,46 @@ void Layer::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
+LayerCache::LayerCache(std::shared_ptr<std::atomic<long>> generation)
+  : lock(), generation(generation), extent_generation(-1), extent(), count_generation(-1), count(0) {
+}
+
+bool LayerCache::getExtent(OGREnvelope &envelope) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (extent_generation != *generation) return false;
+  envelope = extent;
+  return true;
+}
+
+void LayerCache::setExtent(const OGREnvelope &envelope) {
+  std::lock_guard<std::mutex> guard(lock);
+  extent = envelope;
+  extent_generation = *generation;
+}
+
+bool LayerCache::getCount(GIntBig &value) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (count_generation != *generation) return false;
+  value = count;
+  return true;
+}
+
+void LayerCache::setCount(GIntBig value) {
+  std::lock_guard<std::mutex> guard(lock);
+  count = value;
+  count_generation = *generation;
+}
+
+void LayerCache::reset() {
+  std::lock_guard<std::mutex> guard(lock);
+  extent_generation = -1;
+  count_generation = -1;
+}
+
+void LayerCache::modified() {
+  (*generation)++;
+}
+
 Layer::Layer(OGRLayer *layer) : Nan::ObjectWrap(), uid(0), this_(layer), parent_ds(0) {
   LOG("Created layer [%p]", layer);
 }
@@ -139,6 +179,7 @@ Local<Value> Layer::New(OGRLayer *raw, GDALDataset *raw_parent, bool result_set)
   wrapped->uid = object_store.add(raw, wrapped->persistent(), parent_uid, result_set);
   wrapped->parent_ds = raw_parent;
   wrapped->parent_uid = parent_uid;
+  wrapped->cache = std::make_shared<LayerCache>(unwrapped->generation);
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
@@ -193,9 +234,21 @@ NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_LOCKED(Layer, syncToDisk, SyncToDis
  */
 NODE_WRAPPED_METHOD_WITH_RESULT_1_STRING_PARAM_LOCKED(Layer, testCapability, Boolean, TestCapability, "capability");
 
+static Local<Value> envelopeToObject(const OGREnvelope &envelope) {
+  Nan::EscapableHandleScope scope;
+  Local<Object> obj = Nan::New<Object>();
+  Nan::Set(obj, Nan::New("minX").ToLocalChecked(), Nan::New<Number>(envelope.MinX));
+  Nan::Set(obj, Nan::New("maxX").ToLocalChecked(), Nan::New<Number>(envelope.MaxX));
+  Nan::Set(obj, Nan::New("minY").ToLocalChecked(), Nan::New<Number>(envelope.MinY));
+  Nan::Set(obj, Nan::New("maxY").ToLocalChecked(), Nan::New<Number>(envelope.MaxY));
+  return scope.Escape(obj);
+}
+
 /**
  * Fetch the extent of this layer.
  *
+ * The result is cached until the filters are changed or the Dataset is modified.
+ *
  * @throws {Error}
  * @method getExtent
  * @instance
@@ -203,7 +256,23 @@ NODE_WRAPPED_METHOD_WITH_RESULT_1_STRING_PARAM_LOCKED(Layer, testCapability, Boo
  * @param {boolean} [force=true]
  * @return {Envelope} Bounding envelope
  */
-NAN_METHOD(Layer::getExtent) {
+
+/**
+ * Fetch the extent of this layer.
+ * @async
+ *
+ * The result is cached until the filters are changed or the Dataset is modified,
+ * a cached value is returned without waiting for the Dataset to be available.
+ *
+ * @throws {Error}
+ * @method getExtentAsync
+ * @instance
+ * @memberof Layer
+ * @param {boolean} [force=true]
+ * @param {callback<Envelope>} [callback=undefined]
+ * @return {Promise<Envelope>} Bounding envelope
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::getExtent) {
 
   Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
   if (!layer->isAlive()) {
@@ -214,26 +283,33 @@ NAN_METHOD(Layer::getExtent) {
   int force = 1;
   NODE_ARG_BOOL_OPT(0, "force", force);
 
-  std::unique_ptr<OGREnvelope> envelope(new OGREnvelope());
-  GDAL_LOCK_PARENT(layer);
-  OGRErr err = layer->this_->GetExtent(envelope.get(), force);
-
-  if (err) {
-    Nan::ThrowError("Can't get layer extent without computing it");
+  std::shared_ptr<LayerCache> cache = layer->cache;
+  OGREnvelope cached;
+  if (cache->getExtent(cached)) {
+    // A cached value does not need the Dataset lock
+    GDALAsyncableJob<OGREnvelope> job(0);
+    job.main = [cached](const GDALExecutionProgress &) { return cached; };
+    job.rval = [](OGREnvelope envelope, const GetFromPersistentFunc &) { return envelopeToObject(envelope); };
+    job.run(info, async, 1);
     return;
   }
 
-  Local<Object> obj = Nan::New<Object>();
-  Nan::Set(obj, Nan::New("minX").ToLocalChecked(), Nan::New<Number>(envelope->MinX));
-  Nan::Set(obj, Nan::New("maxX").ToLocalChecked(), Nan::New<Number>(envelope->MaxX));
-  Nan::Set(obj, Nan::New("minY").ToLocalChecked(), Nan::New<Number>(envelope->MinY));
-  Nan::Set(obj, Nan::New("maxY").ToLocalChecked(), Nan::New<Number>(envelope->MaxY));
-
-  info.GetReturnValue().Set(obj);
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<OGREnvelope> job(layer->parent_uid);
+  job.main = [gdal_layer, force, cache](const GDALExecutionProgress &) {
+    OGREnvelope envelope;
+    OGRErr err = gdal_layer->GetExtent(&envelope, force);
+    if (err) throw "Can't get layer extent without computing it";
+    // An approximate extent must not be returned for force=true
+    if (force) cache->setExtent(envelope);
+    return envelope;
+  };
+  job.rval = [](OGREnvelope envelope, const GetFromPersistentFunc &) { return envelopeToObject(envelope); };
+  job.run(info, async, 1);
 }
 
 /**
- * This method returns the current spatial filter for this layer.
+ * This method returns a copy of the current spatial filter for this layer.
  *
  * @throws {Error}
  * @method getSpatialFilter
@@ -241,7 +317,19 @@ NAN_METHOD(Layer::getExtent) {
  * @memberof Layer
  * @return {Geometry}
  */
-NAN_METHOD(Layer::getSpatialFilter) {
+
+/**
+ * This method returns a copy of the current spatial filter for this layer.
+ * @async
+ *
+ * @throws {Error}
+ * @method getSpatialFilterAsync
+ * @instance
+ * @memberof Layer
+ * @param {callback<Geometry>} [callback=undefined]
+ * @return {Promise<Geometry>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::getSpatialFilter) {
 
   Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
   if (!layer->isAlive()) {
@@ -249,10 +337,14 @@ NAN_METHOD(Layer::getSpatialFilter) {
     return;
   }
 
-  GDAL_LOCK_PARENT(layer);
-  auto r = layer->this_->GetSpatialFilter();
-
-  info.GetReturnValue().Set(Geometry::New(r, false));
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<OGRGeometry *> job(layer->parent_uid);
+  job.main = [gdal_layer](const GDALExecutionProgress &) {
+    OGRGeometry *filter = gdal_layer->GetSpatialFilter();
+    return filter ? filter->clone() : nullptr;
+  };
+  job.rval = [](OGRGeometry *filter, const GetFromPersistentFunc &) { return Geometry::New(filter, true); };
+  job.run(info, async, 0);
 }
 
 /**
@@ -293,7 +385,52 @@ NAN_METHOD(Layer::getSpatialFilter) {
  * @param {number} maxX
  * @param {number} maxY
  */
-NAN_METHOD(Layer::setSpatialFilter) {
+
+/**
+ * This method sets the geometry to be used as a spatial filter when fetching
+ * features via the `layer.features.next()` method. Only features that
+ * geometrically intersect the filter geometry will be returned.
+ * @async
+ *
+ * Alernatively you can pass it envelope bounds as individual arguments.
+ *
+ * @example
+ *
+ * await layer.setSpatialFilterAsync(geometry);
+ *
+ * @throws {Error}
+ * @method setSpatialFilterAsync
+ * @instance
+ * @memberof Layer
+ * @param {Geometry|null} filter
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+
+/**
+ * This method sets the geometry to be used as a spatial filter when fetching
+ * features via the `layer.features.next()` method. Only features that
+ * geometrically intersect the filter geometry will be returned.
+ * @async
+ *
+ * Alernatively you can pass it envelope bounds as individual arguments.
+ *
+ * @example
+ *
+ * await layer.setSpatialFilterAsync(minX, minY, maxX, maxY);
+ *
+ * @throws {Error}
+ * @method setSpatialFilterAsync
+ * @instance
+ * @memberof Layer
+ * @param {number} minxX
+ * @param {number} minyY
+ * @param {number} maxX
+ * @param {number} maxY
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::setSpatialFilter) {
 
   Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
   if (!layer->isAlive()) {
@@ -301,31 +438,39 @@ NAN_METHOD(Layer::setSpatialFilter) {
     return;
   }
 
-  if (info.Length() == 1) {
-    Geometry *filter = NULL;
-    NODE_ARG_WRAPPED_OPT(0, "filter", Geometry, filter);
-
-    GDAL_LOCK_PARENT(layer);
-    if (filter) {
-      layer->this_->SetSpatialFilter(filter->get());
-    } else {
-      layer->this_->SetSpatialFilter(NULL);
-    }
-  } else if (info.Length() == 4) {
+  OGRLayer *gdal_layer = layer->get();
+  std::shared_ptr<LayerCache> cache = layer->cache;
+  GDALAsyncableJob<int> job(layer->parent_uid);
+  // The async version always receives the callback argument
+  if (info.Length() > 1 && info[0]->IsNumber()) {
     double minX, minY, maxX, maxY;
     NODE_ARG_DOUBLE(0, "minX", minX);
     NODE_ARG_DOUBLE(1, "minY", minY);
     NODE_ARG_DOUBLE(2, "maxX", maxX);
     NODE_ARG_DOUBLE(3, "maxY", maxY);
 
-    GDAL_LOCK_PARENT(layer);
-    layer->this_->SetSpatialFilterRect(minX, minY, maxX, maxY);
+    job.main = [gdal_layer, cache, minX, minY, maxX, maxY](const GDALExecutionProgress &) {
+      gdal_layer->SetSpatialFilterRect(minX, minY, maxX, maxY);
+      cache->reset();
+      return 0;
+    };
+  } else if (info.Length() == 1 || async) {
+    Geometry *filter = NULL;
+    NODE_ARG_WRAPPED_OPT(0, "filter", Geometry, filter);
+
+    // The worker thread uses its own copy of the filter
+    std::shared_ptr<OGRGeometry> geom(filter ? filter->get()->clone() : nullptr);
+    job.main = [gdal_layer, cache, geom](const GDALExecutionProgress &) {
+      gdal_layer->SetSpatialFilter(geom.get());
+      cache->reset();
+      return 0;
+    };
   } else {
     Nan::ThrowError("Invalid number of arguments");
     return;
   }
-
-  return;
+  job.rval = [](int, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 4);
 }
 
 /**
@@ -352,7 +497,26 @@ NAN_METHOD(Layer::setSpatialFilter) {
  * @memberof Layer
  * @param {string|null} [filter=null]
  */
-NAN_METHOD(Layer::setAttributeFilter) {
+
+/**
+ * Sets the attribute query string to be used when fetching features via the
+ * `layer.features.next()` method. Only features for which the query evaluates
+ * as `true` will be returned.
+ * @async
+ *
+ * @example
+ *
+ * await layer.setAttributeFilterAsync('population > 1000000 and population < 5000000');
+ *
+ * @throws {Error}
+ * @method setAttributeFilterAsync
+ * @instance
+ * @memberof Layer
+ * @param {string|null} [filter=null]
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::setAttributeFilter) {
 
   Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
   if (!layer->isAlive()) {
@@ -363,20 +527,17 @@ NAN_METHOD(Layer::setAttributeFilter) {
   std::string filter = "";
   NODE_ARG_OPT_STR(0, "filter", filter);
 
-  OGRErr err;
-  GDAL_LOCK_PARENT(layer);
-  if (filter.empty()) {
-    err = layer->this_->SetAttributeFilter(NULL);
-  } else {
-    err = layer->this_->SetAttributeFilter(filter.c_str());
-  }
-
-  if (err) {
-    NODE_THROW_OGRERR(err);
-    return;
-  }
-
-  return;
+  OGRLayer *gdal_layer = layer->get();
+  std::shared_ptr<LayerCache> cache = layer->cache;
+  GDALAsyncableJob<OGRErr> job(layer->parent_uid);
+  job.main = [gdal_layer, cache, filter](const GDALExecutionProgress &) {
+    OGRErr err = gdal_layer->SetAttributeFilter(filter.empty() ? NULL : filter.c_str());
+    cache->reset();
+    if (err) throw getOGRErrMsg(err);
+    return err;
+  };
+  job.rval = [](OGRErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
 }
 
 /*
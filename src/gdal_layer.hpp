@@ -13,11 +13,40 @@
 
 #include "gdal_dataset.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 using namespace v8;
 using namespace node;
 
 namespace node_gdal {
 
+// Extent and feature count of a layer computed under its current filters,
+// valid until the next write operation on its Dataset
+// Only the exact values (force=true) are stored, in the worker thread while holding the Dataset lock
+// and can be retrieved from the main thread without it
+class LayerCache {
+    public:
+  LayerCache(std::shared_ptr<std::atomic<long>> generation);
+  bool getExtent(OGREnvelope &envelope);
+  void setExtent(const OGREnvelope &envelope);
+  bool getCount(GIntBig &count);
+  void setCount(GIntBig count);
+  // The filters have changed
+  void reset();
+  // The Dataset has been modified, invalidates all of its layers
+  void modified();
+
+    private:
+  std::mutex lock;
+  std::shared_ptr<std::atomic<long>> generation;
+  long extent_generation;
+  OGREnvelope extent;
+  long count_generation;
+  GIntBig count;
+};
+
 class Layer : public Nan::ObjectWrap {
     public:
   static Nan::Persistent<FunctionTemplate> constructor;
@@ -26,10 +55,10 @@ class Layer : public Nan::ObjectWrap {
   static Local<Value> New(OGRLayer *raw, GDALDataset *raw_parent);
   static Local<Value> New(OGRLayer *raw, GDALDataset *raw_parent, bool result_set);
   static NAN_METHOD(toString);
-  static NAN_METHOD(getExtent);
-  static NAN_METHOD(setAttributeFilter);
-  static NAN_METHOD(setSpatialFilter);
-  static NAN_METHOD(getSpatialFilter);
+  GDAL_ASYNCABLE_DECLARE(getExtent);
+  GDAL_ASYNCABLE_DECLARE(setAttributeFilter);
+  GDAL_ASYNCABLE_DECLARE(setSpatialFilter);
+  GDAL_ASYNCABLE_DECLARE(getSpatialFilter);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(syncToDisk);
 
@@ -58,6 +87,7 @@ class Layer : public Nan::ObjectWrap {
   void dispose();
   long uid;
   long parent_uid;
+  std::shared_ptr<LayerCache> cache;
 
     private:
   ~Layer();
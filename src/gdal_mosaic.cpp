@@ -0,0 +1,449 @@
+#include "gdal_mosaic.hpp"
+#include "gdal_common.hpp"
+#include "gdal_dataset.hpp"
+#include "gdal_rasterband.hpp"
+#include "gdal_spatial_reference.hpp"
+#include "collections/rasterband_pixels.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace node_gdal {
+
+void Mosaic::Initialize(Local<Object> target) {
+  Nan__SetAsyncableMethod(target, "mosaicRead", mosaicRead);
+}
+
+namespace {
+
+// Default number of threads of a job, the jobs themselves
+// already run in parallel on the libuv thread pool
+const int DEFAULT_THREADS = 2;
+
+// GDALDataset::GetSpatialRef() requires GDAL 3.0
+std::shared_ptr<OGRSpatialReference> datasetSRS(GDALDataset *ds) {
+  const char *wkt = ds->GetProjectionRef();
+  if (wkt == nullptr || *wkt == '\0') return nullptr;
+  return std::make_shared<OGRSpatialReference>(wkt);
+}
+
+struct Window {
+  double min_x, min_y, max_x, max_y;
+  int w, h;
+};
+
+// The pixels of one source in the output data type,
+// dst_* is the region of the output buffer they cover
+struct Tile {
+  bool valid;
+  int dst_x, dst_y, dst_w, dst_h;
+  std::vector<uint8_t> data;
+  // Empty when all pixels are valid
+  std::vector<uint8_t> mask;
+};
+
+// Intersect the footprint of a north-up source with the output window,
+// returns false if the source is outside or if it is rotated
+bool footprint(const double *gt, int x_size, int y_size, const Window &win, double *bounds) {
+  if (gt[2] != 0 || gt[4] != 0) return false;
+  double x0 = gt[0], x1 = gt[0] + gt[1] * x_size;
+  double y0 = gt[3], y1 = gt[3] + gt[5] * y_size;
+  bounds[0] = std::max(win.min_x, std::min(x0, x1));
+  bounds[1] = std::max(win.min_y, std::min(y0, y1));
+  bounds[2] = std::min(win.max_x, std::max(x0, x1));
+  bounds[3] = std::min(win.max_y, std::max(y0, y1));
+  return bounds[0] < bounds[2] && bounds[1] < bounds[3];
+}
+
+// Read the part of a source that intersects the output window,
+// the destination region is aligned on the output pixels and
+// the source region is a floating point window
+void readTile(
+  GDALRasterBand *band, const double *gt, const Window &win, GDALDataType type, GDALRIOResampleAlg resampling,
+  Tile &tile) {
+  tile.valid = false;
+  double bounds[4];
+  if (!footprint(gt, band->GetXSize(), band->GetYSize(), win, bounds)) return;
+
+  double res_x = (win.max_x - win.min_x) / win.w;
+  double res_y = (win.max_y - win.min_y) / win.h;
+  int dst_x0 = static_cast<int>(std::round((bounds[0] - win.min_x) / res_x));
+  int dst_x1 = static_cast<int>(std::round((bounds[2] - win.min_x) / res_x));
+  int dst_y0 = static_cast<int>(std::round((win.max_y - bounds[3]) / res_y));
+  int dst_y1 = static_cast<int>(std::round((win.max_y - bounds[1]) / res_y));
+  dst_x0 = std::max(0, dst_x0);
+  dst_y0 = std::max(0, dst_y0);
+  dst_x1 = std::min(win.w, dst_x1);
+  dst_y1 = std::min(win.h, dst_y1);
+  if (dst_x1 <= dst_x0 || dst_y1 <= dst_y0) return;
+
+  auto clamp = [](double v, int max) { return std::min(std::max(v, 0.0), static_cast<double>(max)); };
+  double src_xa = clamp((win.min_x + dst_x0 * res_x - gt[0]) / gt[1], band->GetXSize());
+  double src_xb = clamp((win.min_x + dst_x1 * res_x - gt[0]) / gt[1], band->GetXSize());
+  double src_ya = clamp((win.max_y - dst_y0 * res_y - gt[3]) / gt[5], band->GetYSize());
+  double src_yb = clamp((win.max_y - dst_y1 * res_y - gt[3]) / gt[5], band->GetYSize());
+  double src_x0 = std::min(src_xa, src_xb), src_x1 = std::max(src_xa, src_xb);
+  double src_y0 = std::min(src_ya, src_yb), src_y1 = std::max(src_ya, src_yb);
+  if (src_x1 <= src_x0 || src_y1 <= src_y0) return;
+
+  int x = static_cast<int>(std::floor(src_x0));
+  int y = static_cast<int>(std::floor(src_y0));
+  int w = std::min(band->GetXSize() - x, std::max(1, static_cast<int>(std::ceil(src_x1)) - x));
+  int h = std::min(band->GetYSize() - y, std::max(1, static_cast<int>(std::ceil(src_y1)) - y));
+
+  tile.dst_x = dst_x0;
+  tile.dst_y = dst_y0;
+  tile.dst_w = dst_x1 - dst_x0;
+  tile.dst_h = dst_y1 - dst_y0;
+
+  GDALRasterIOExtraArg extra;
+  INIT_RASTERIO_EXTRA_ARG(extra);
+  extra.eResampleAlg = resampling;
+  extra.bFloatingPointWindowValidity = TRUE;
+  extra.dfXOff = src_x0;
+  extra.dfYOff = src_y0;
+  extra.dfXSize = src_x1 - src_x0;
+  extra.dfYSize = src_y1 - src_y0;
+
+  int bytes_per_pixel = GDALGetDataTypeSizeBytes(type);
+  tile.data.resize(static_cast<size_t>(tile.dst_w) * tile.dst_h * bytes_per_pixel);
+  CPLErr err =
+    band->RasterIO(GF_Read, x, y, w, h, tile.data.data(), tile.dst_w, tile.dst_h, type, 0, 0, &extra);
+  if (err != CE_None) throw CPLGetLastErrorMsg();
+
+  if (band->GetMaskFlags() != GMF_ALL_VALID) {
+    // The mask is never interpolated, a pixel is either taken or not
+    extra.eResampleAlg = GRIORA_NearestNeighbour;
+    tile.mask.resize(static_cast<size_t>(tile.dst_w) * tile.dst_h);
+    err = band->GetMaskBand()->RasterIO(
+      GF_Read, x, y, w, h, tile.mask.data(), tile.dst_w, tile.dst_h, GDT_Byte, 0, 0, &extra);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+  }
+  tile.valid = true;
+}
+
+void compose(const Tile &tile, uint8_t *data, int width, int bytes_per_pixel) {
+  size_t row = static_cast<size_t>(tile.dst_w) * bytes_per_pixel;
+  for (int j = 0; j < tile.dst_h; j++) {
+    uint8_t *dst = data + (static_cast<size_t>(tile.dst_y + j) * width + tile.dst_x) * bytes_per_pixel;
+    const uint8_t *src = tile.data.data() + j * row;
+    if (tile.mask.empty()) {
+      memcpy(dst, src, row);
+      continue;
+    }
+    const uint8_t *mask = tile.mask.data() + static_cast<size_t>(j) * tile.dst_w;
+    for (int i = 0; i < tile.dst_w; i++)
+      if (mask[i]) memcpy(dst + i * bytes_per_pixel, src + i * bytes_per_pixel, bytes_per_pixel);
+  }
+}
+
+} // namespace
+
+/**
+ * @typedef {object} MosaicOptions
+ * @property {number} [width] Width of the output buffer in pixels
+ * @property {number} [height] Height of the output buffer in pixels
+ * @property {number|number[]} [resolution] Pixel size in georeferenced units, a single value or `[x, y]`, used when `width` and `height` are not specified
+ * @property {SpatialReference} [srs] SRS of the window, the sources must be in the same SRS
+ * @property {string} [resampling] Resampling algorithm, `NearestNeighbour` by default, see {@link RasterBandPixels.read}
+ * @property {number} [nodata] Value of the pixels not covered by any source, the nodata value of the first source or `0` by default
+ * @property {string} [order] `last` (default) to let the later sources cover the previous ones as in a VRT mosaic or `first` to keep the first source covering a pixel
+ * @property {string} [data_type] Data type of the output buffer, the data type of the first source by default
+ * @property {number} [threads=2] Maximum number of datasets read in parallel by one call
+ */
+
+/**
+ * Read a georeferenced window from many raster bands into one buffer.
+ *
+ * Only the sources that intersect the window are read. The sources are
+ * located by their geotransform, they must be north-up and in the same SRS.
+ * The pixels that are masked in a source (nodata, alpha or mask band)
+ * do not cover the other sources.
+ *
+ * The sources of different datasets are read in parallel.
+ * This is equivalent to building a VRT mosaic and reading it,
+ * without the intermediate VRT.
+ *
+ * @example
+ * const tiles = files.map((f) => gdal.open(f).bands.get(1))
+ * const data = await gdal.mosaicReadAsync(tiles,
+ *   { minX: 500000, minY: 4640000, maxX: 520000, maxY: 4660000 },
+ *   { resolution: 10, resampling: 'Bilinear' })
+ *
+ * @throws {Error}
+ * @method mosaicRead
+ * @static
+ * @param {RasterBand[]} sources
+ * @param {Envelope} window Georeferenced window to read
+ * @param {MosaicOptions} options
+ * @return {TypedArray}
+ */
+
+/**
+ * Read a georeferenced window from many raster bands into one buffer.
+ * @async
+ *
+ * Only the sources that intersect the window are read. The sources are
+ * located by their geotransform, they must be north-up and in the same SRS.
+ * The pixels that are masked in a source (nodata, alpha or mask band)
+ * do not cover the other sources.
+ *
+ * The sources of different datasets are read in parallel.
+ * This is equivalent to building a VRT mosaic and reading it,
+ * without the intermediate VRT.
+ *
+ * @throws {Error}
+ * @method mosaicReadAsync
+ * @static
+ * @param {RasterBand[]} sources
+ * @param {Envelope} window Georeferenced window to read
+ * @param {MosaicOptions} options
+ * @param {callback<TypedArray>} [callback=undefined]
+ * @return {Promise<TypedArray>}
+ */
+GDAL_ASYNCABLE_DEFINE(Mosaic::mosaicRead) {
+  Local<Array> sources_array;
+  Local<Object> window_obj;
+  Local<Object> options;
+  NODE_ARG_ARRAY(0, "sources", sources_array);
+  NODE_ARG_OBJECT(1, "window", window_obj);
+  NODE_ARG_OBJECT(2, "options", options);
+
+  Window win = {0, 0, 0, 0, 0, 0};
+  NODE_DOUBLE_FROM_OBJ(window_obj, "minX", win.min_x);
+  NODE_DOUBLE_FROM_OBJ(window_obj, "minY", win.min_y);
+  NODE_DOUBLE_FROM_OBJ(window_obj, "maxX", win.max_x);
+  NODE_DOUBLE_FROM_OBJ(window_obj, "maxY", win.max_y);
+  if (!(win.max_x > win.min_x) || !(win.max_y > win.min_y)) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+
+  NODE_INT_FROM_OBJ_OPT(options, "width", win.w);
+  NODE_INT_FROM_OBJ_OPT(options, "height", win.h);
+  if (win.w == 0 && win.h == 0 && Nan::HasOwnProperty(options, Nan::New("resolution").ToLocalChecked()).FromJust()) {
+    Local<Value> res = Nan::Get(options, Nan::New("resolution").ToLocalChecked()).ToLocalChecked();
+    double res_x = 0, res_y = 0;
+    if (res->IsNumber()) {
+      res_x = res_y = Nan::To<double>(res).ToChecked();
+    } else if (res->IsArray() && res.As<Array>()->Length() == 2) {
+      res_x = Nan::To<double>(Nan::Get(res.As<Array>(), 0).ToLocalChecked()).FromMaybe(0);
+      res_y = Nan::To<double>(Nan::Get(res.As<Array>(), 1).ToLocalChecked()).FromMaybe(0);
+    }
+    if (!(res_x > 0) || !(res_y > 0)) {
+      Nan::ThrowTypeError("resolution must be a positive number or an array of two positive numbers");
+      return;
+    }
+    win.w = static_cast<int>(std::round((win.max_x - win.min_x) / res_x));
+    win.h = static_cast<int>(std::round((win.max_y - win.min_y) / res_y));
+  }
+  if (win.w <= 0 || win.h <= 0) {
+    Nan::ThrowRangeError("width and height or resolution must be specified and result in a non-empty buffer");
+    return;
+  }
+
+  SpatialReference *srs = nullptr;
+  NODE_WRAPPED_FROM_OBJ_OPT(options, "srs", SpatialReference, srs);
+  std::shared_ptr<OGRSpatialReference> target_srs;
+  if (srs) target_srs = std::shared_ptr<OGRSpatialReference>(srs->get()->Clone());
+
+  GDALRIOResampleAlg resampling;
+  try {
+    resampling = parseResamplingAlg(Nan::Get(options, Nan::New("resampling").ToLocalChecked()).ToLocalChecked());
+  } catch (const char *e) {
+    Nan::ThrowError(e);
+    return;
+  }
+
+  bool has_nodata = false;
+  double nodata = 0;
+  if (Nan::HasOwnProperty(options, Nan::New("nodata").ToLocalChecked()).FromJust()) {
+    NODE_DOUBLE_FROM_OBJ(options, "nodata", nodata);
+    has_nodata = true;
+  }
+
+  std::string order = "last";
+  NODE_STR_FROM_OBJ_OPT(options, "order", order);
+  if (order != "first" && order != "last") {
+    Nan::ThrowRangeError("order must be \"first\" or \"last\"");
+    return;
+  }
+
+  std::string type_name;
+  NODE_STR_FROM_OBJ_OPT(options, "data_type", type_name);
+
+  int threads = DEFAULT_THREADS;
+  NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  threads = std::max(threads, 1);
+
+  // The sources of read-only datasets are selected here, without locking them,
+  // from the geotransforms captured when the datasets were opened
+  struct Source {
+    GDALRasterBand *band;
+    GDALDataset *ds;
+    long ds_uid;
+  };
+  auto sources = std::make_shared<std::vector<Source>>();
+  std::vector<long> uids;
+  GDALDataType type = GDT_Unknown;
+  // The default nodata value comes from the first source even when it is outside of the window
+  GDALRasterBand *first_band = nullptr;
+  // Protects the bands and through them their datasets from the GC while the job is running
+  std::vector<Local<Object>> band_objs;
+  for (unsigned i = 0; i < sources_array->Length(); i++) {
+    Local<Value> val = Nan::Get(sources_array, i).ToLocalChecked();
+    if (!IS_WRAPPED(val, RasterBand)) {
+      Nan::ThrowTypeError("sources must be an array of RasterBand objects");
+      return;
+    }
+    RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(val.As<Object>());
+    if (!band->isAlive()) {
+      THROW_OR_REJECT("RasterBand object has already been destroyed");
+      return;
+    }
+    band_objs.push_back(band->handle());
+    if (i == 0) {
+      type = band->get()->GetRasterDataType();
+      first_band = band->get();
+      uids.push_back(band->parent_uid);
+    }
+    Local<Value> ds_obj = Nan::GetPrivate(val.As<Object>(), Nan::New("ds_").ToLocalChecked()).ToLocalChecked();
+    Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(ds_obj.As<Object>());
+    if (ds->snapshot.valid) {
+      double bounds[4];
+      if (!ds->snapshot.has_geotransform) {
+        Nan::ThrowError("All sources must have a geotransform");
+        return;
+      }
+      if (!footprint(ds->snapshot.geotransform, ds->snapshot.x, ds->snapshot.y, win, bounds)) continue;
+    }
+    sources->push_back({band->get(), band->getParent(), band->parent_uid});
+    uids.push_back(band->parent_uid);
+  }
+
+  if (!type_name.empty()) type = GDALGetDataTypeByName(type_name.c_str());
+  if (type == GDT_Unknown) {
+    Nan::ThrowError("Invalid GDAL data type");
+    return;
+  }
+  int bytes_per_pixel = GDALGetDataTypeSizeBytes(type);
+  int64_t length = static_cast<int64_t>(win.w) * win.h;
+
+  Local<Value> array = TypedArray::New(type, length);
+  if (array.IsEmpty() || !array->IsObject()) {
+    return; // TypedArray::New threw an error
+  }
+  Local<Object> obj = array.As<Object>();
+  uint8_t *data = static_cast<uint8_t *>(TypedArray::Validate(obj, type, length));
+  if (!data) return;
+
+  // Without sources there is nothing to lock, same as job(0)
+  if (uids.empty()) uids.push_back(0);
+  GDALAsyncableJob<CPLErr> job(uids);
+  job.persist("array", obj);
+  job.persist(band_objs);
+  job.size = length * bytes_per_pixel;
+  bool first = order == "first";
+  job.main = [sources,
+              first_band,
+              win,
+              type,
+              bytes_per_pixel,
+              resampling,
+              has_nodata,
+              nodata,
+              first,
+              threads,
+              target_srs,
+              data](const GDALExecutionProgress &) {
+    const size_t n = sources->size();
+    std::vector<Tile> tiles(n);
+
+    // The bands of the same dataset are read sequentially by the same thread
+    std::map<long, std::vector<size_t>> by_dataset;
+    for (size_t i = 0; i < n; i++) by_dataset[(*sources)[i].ds_uid].push_back(i);
+    std::vector<std::vector<size_t>> groups;
+    for (auto &g : by_dataset) groups.push_back(g.second);
+
+    std::shared_ptr<OGRSpatialReference> srs = target_srs;
+    for (size_t i = 0; i < n && !srs; i++) srs = datasetSRS((*sources)[i].ds);
+
+    std::atomic<size_t> next(0);
+    std::mutex error_lock;
+    std::string error;
+    auto worker = [&]() {
+      size_t g;
+      while ((g = next++) < groups.size()) {
+        for (size_t i : groups[g]) {
+          const Source &source = (*sources)[i];
+          try {
+            double gt[6];
+            if (source.ds->GetGeoTransform(gt) != CE_None) throw "All sources must have a geotransform";
+            if (gt[2] != 0 || gt[4] != 0) throw "Rotated sources are not supported";
+            std::shared_ptr<OGRSpatialReference> s = datasetSRS(source.ds);
+            if (s && srs && !s->IsSame(srs.get())) throw "All sources must be in the same SRS";
+            CPLErrorReset();
+            readTile(source.band, gt, win, type, resampling, tiles[i]);
+          } catch (const char *e) {
+            std::lock_guard<std::mutex> lock(error_lock);
+            if (error.empty()) error = e;
+            return;
+          }
+        }
+      }
+    };
+
+    size_t n_threads = std::min(groups.size(), static_cast<size_t>(threads));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < n_threads; t++) workers.emplace_back(worker);
+    worker();
+    for (auto &w : workers) w.join();
+
+    if (!error.empty()) {
+      CPLError(CE_Failure, CPLE_AppDefined, "%s", error.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+
+    double fill = nodata;
+    if (!has_nodata) {
+      int source_has_nodata = 0;
+      fill = first_band ? first_band->GetNoDataValue(&source_has_nodata) : 0;
+      if (!source_has_nodata) fill = 0;
+    }
+    const size_t length = static_cast<size_t>(win.w) * win.h;
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 3)
+    GDALCopyWords64(&fill, GDT_Float64, 0, data, type, bytes_per_pixel, static_cast<GPtrDiff_t>(length));
+#else
+    const size_t chunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    for (size_t done = 0; done < length; done += chunk)
+      GDALCopyWords(
+        &fill,
+        GDT_Float64,
+        0,
+        data + done * bytes_per_pixel,
+        type,
+        bytes_per_pixel,
+        static_cast<int>(std::min(chunk, length - done)));
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+      const Tile &tile = tiles[first ? n - 1 - i : i];
+      if (tile.valid) compose(tile, data, win.w, bytes_per_pixel);
+    }
+    return CE_None;
+  };
+  job.rval = [](CPLErr, const GetFromPersistentFunc &getter) { return getter("array"); };
+  job.run(info, async, 3);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,30 @@
+#ifndef __GDAL_MOSAIC_H__
+#define __GDAL_MOSAIC_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "async.hpp"
+
+using namespace v8;
+using namespace node;
+
+// Reading a window from many georeferenced sources into a single buffer
+
+namespace node_gdal {
+namespace Mosaic {
+
+void Initialize(Local<Object> target);
+
+GDAL_ASYNCABLE_GLOBAL(mosaicRead);
+} // namespace Mosaic
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,962 @@
+#include "gdal_raster_index.hpp"
+#include "gdal_common.hpp"
+#include "gdal_layer.hpp"
+#include "gdal_spatial_reference.hpp"
+
+#include <cpl_time.h>
+#include <cpl_vsi.h>
+#include <ogr_spatialref.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> RasterIndex::constructor;
+
+// Number of children of a node of the tree
+static const size_t NODE_SIZE = 16;
+
+static const char MAGIC[8] = {'N', 'G', 'R', 'I', 'D', 'X', '\0', '\0'};
+static const uint32_t VERSION = 1;
+static const uint32_t BYTE_ORDER = 0x01020304;
+
+void RasterIndex::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(RasterIndex::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("RasterIndex").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "get", get);
+  Nan::SetPrototypeMethod(lcons, "search", search);
+  Nan__SetPrototypeAsyncableMethod(lcons, "save", save);
+  Nan__SetAsyncableMethod(lcons, "load", load);
+  Nan__SetAsyncableMethod(lcons, "fromFiles", fromFiles);
+  Nan__SetAsyncableMethod(lcons, "fromLayer", fromLayer);
+
+  ATTR(lcons, "count", countGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("RasterIndex").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+RasterIndex::RasterIndex() : Nan::ObjectWrap(), data(std::make_shared<Data>()) {
+}
+
+RasterIndex::~RasterIndex() {
+}
+
+RasterIndex::Data::Data() : entries(), srs_table({""}), srs_lookup({{"", 0}}), indexed(true) {
+}
+
+uint32_t RasterIndex::Data::addSRS(const std::string &srs) {
+  auto it = srs_lookup.find(srs);
+  if (it != srs_lookup.end()) return it->second;
+  uint32_t id = static_cast<uint32_t>(srs_table.size());
+  srs_table.push_back(srs);
+  srs_lookup[srs] = id;
+  return id;
+}
+
+// Position of (x, y) on the Hilbert curve of order 16
+// https://github.com/rawrunprotected/hilbert_curves (public domain)
+static uint32_t hilbert(uint32_t x, uint32_t y) {
+  uint32_t a = x ^ y;
+  uint32_t b = 0xFFFF ^ a;
+  uint32_t c = 0xFFFF ^ (x | y);
+  uint32_t d = x & (y ^ 0xFFFF);
+
+  uint32_t A = a | (b >> 1);
+  uint32_t B = (a >> 1) ^ a;
+  uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+  uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+  B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+  C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+  D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+  B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+  C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+  D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+  D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+  a = C ^ (C >> 1);
+  b = D ^ (D >> 1);
+
+  uint32_t i0 = x ^ y;
+  uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+  i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+  i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+  i0 = (i0 | (i0 << 2)) & 0x33333333;
+  i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+  i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+  i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+  i1 = (i1 | (i1 << 2)) & 0x33333333;
+  i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+  return (i1 << 1) | i0;
+}
+
+// Sort the entries by the Hilbert value of their centers (unless the order
+// is known) and pack every NODE_SIZE consecutive boxes into a parent node
+// until the top level fits in a single node
+void RasterIndex::Data::build(const std::vector<uint32_t> *order) {
+  const size_t n = entries.size();
+  boxes.clear();
+  level_end.clear();
+
+  if (order) {
+    index = *order;
+  } else {
+    index.resize(n);
+    for (size_t i = 0; i < n; i++) index[i] = static_cast<uint32_t>(i);
+    double min_x = std::numeric_limits<double>::infinity(), min_y = min_x;
+    double max_x = -min_x, max_y = -min_x;
+    for (const Entry &e : entries) {
+      min_x = std::min(min_x, e.bounds[0]);
+      min_y = std::min(min_y, e.bounds[1]);
+      max_x = std::max(max_x, e.bounds[2]);
+      max_y = std::max(max_y, e.bounds[3]);
+    }
+    double w = max_x > min_x ? max_x - min_x : 1;
+    double h = max_y > min_y ? max_y - min_y : 1;
+    std::vector<uint32_t> values(n);
+    for (size_t i = 0; i < n; i++) {
+      const Entry &e = entries[i];
+      uint32_t x = static_cast<uint32_t>(0xFFFF * ((e.bounds[0] + e.bounds[2]) / 2 - min_x) / w);
+      uint32_t y = static_cast<uint32_t>(0xFFFF * ((e.bounds[1] + e.bounds[3]) / 2 - min_y) / h);
+      values[i] = hilbert(x, y);
+    }
+    std::stable_sort(index.begin(), index.end(), [&values](uint32_t a, uint32_t b) { return values[a] < values[b]; });
+  }
+
+  boxes.reserve(n + n / (NODE_SIZE - 1) + 1);
+  for (uint32_t id : index) {
+    const double *b = entries[id].bounds;
+    boxes.push_back({b[0], b[1], b[2], b[3]});
+  }
+  level_end.push_back(n);
+
+  size_t start = 0, end = n;
+  while (end - start > NODE_SIZE) {
+    for (size_t i = start; i < end; i += NODE_SIZE) {
+      std::array<double, 4> box = boxes[i];
+      for (size_t j = i + 1; j < std::min(i + NODE_SIZE, end); j++) {
+        box[0] = std::min(box[0], boxes[j][0]);
+        box[1] = std::min(box[1], boxes[j][1]);
+        box[2] = std::max(box[2], boxes[j][2]);
+        box[3] = std::max(box[3], boxes[j][3]);
+      }
+      boxes.push_back(box);
+      index.push_back(static_cast<uint32_t>(i));
+    }
+    start = end;
+    end = boxes.size();
+    level_end.push_back(end);
+  }
+  indexed = true;
+}
+
+void RasterIndex::Data::search(const double *box, std::vector<uint32_t> &result) const {
+  if (boxes.empty()) return;
+  size_t top = level_end.size() - 1;
+  // (first node of a group of at most NODE_SIZE nodes, level)
+  std::vector<std::pair<size_t, size_t>> stack;
+  stack.push_back({top == 0 ? 0 : level_end[top - 1], top});
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    size_t end = std::min(node.first + NODE_SIZE, level_end[node.second]);
+    for (size_t pos = node.first; pos < end; pos++) {
+      const std::array<double, 4> &b = boxes[pos];
+      if (b[0] > box[2] || b[1] > box[3] || b[2] < box[0] || b[3] < box[1]) continue;
+      if (node.second == 0)
+        result.push_back(index[pos]);
+      else
+        stack.push_back({index[pos], node.second - 1});
+    }
+  }
+}
+
+// The file contains the entries in their original order followed
+// by their order in the tree, the upper levels are rebuilt on load
+//
+// magic[8] version:u32 byte_order:u32
+// srs_count:u32 { length:u32 chars }
+// entry_count:u64 { bounds:f64[4] res_x:f64 res_y:f64 time:f64 srs:u32 length:u32 chars }
+// order:u32[entry_count]
+void RasterIndex::Data::save(const std::string &path) const {
+  VSILFILE *f = VSIFOpenL(path.c_str(), "wb");
+  if (f == nullptr) throw "Failed creating the index file";
+
+  bool ok = true;
+  auto write = [f, &ok](const void *p, size_t size) {
+    if (ok && size > 0) ok = VSIFWriteL(p, 1, size, f) == size;
+  };
+  auto writeString = [&write](const std::string &s) {
+    uint32_t length = static_cast<uint32_t>(s.size());
+    write(&length, sizeof(length));
+    write(s.data(), length);
+  };
+
+  write(MAGIC, sizeof(MAGIC));
+  write(&VERSION, sizeof(VERSION));
+  write(&BYTE_ORDER, sizeof(BYTE_ORDER));
+  uint32_t srs_count = static_cast<uint32_t>(srs_table.size());
+  write(&srs_count, sizeof(srs_count));
+  for (const std::string &srs : srs_table) writeString(srs);
+  uint64_t count = entries.size();
+  write(&count, sizeof(count));
+  for (const Entry &e : entries) {
+    write(e.bounds, sizeof(e.bounds));
+    write(&e.res_x, sizeof(e.res_x));
+    write(&e.res_y, sizeof(e.res_y));
+    write(&e.time, sizeof(e.time));
+    write(&e.srs, sizeof(e.srs));
+    writeString(e.path);
+  }
+  write(index.data(), entries.size() * sizeof(uint32_t));
+
+  if (VSIFCloseL(f) != 0) ok = false;
+  if (!ok) throw "Failed writing the index file";
+}
+
+std::shared_ptr<RasterIndex::Data> RasterIndex::Data::load(const std::string &path) {
+  // The sizes read from the file are checked against its size before allocating
+  VSIStatBufL stat;
+  if (VSIStatL(path.c_str(), &stat) != 0) throw "Failed opening the index file";
+  const uint64_t file_size = static_cast<uint64_t>(stat.st_size);
+  VSILFILE *f = VSIFOpenL(path.c_str(), "rb");
+  if (f == nullptr) throw "Failed opening the index file";
+
+  bool ok = true;
+  auto read = [f, &ok](void *p, size_t size) {
+    if (ok && size > 0) ok = VSIFReadL(p, 1, size, f) == size;
+    return ok;
+  };
+  auto readString = [&read, &ok, file_size](std::string &s) {
+    uint32_t length = 0;
+    if (!read(&length, sizeof(length))) return false;
+    if (length > file_size) {
+      ok = false;
+      return false;
+    }
+    s.resize(length);
+    return read(&s[0], length);
+  };
+
+  auto data = std::make_shared<Data>();
+  char magic[sizeof(MAGIC)];
+  uint32_t version = 0, byte_order = 0, srs_count = 0;
+  uint64_t count = 0;
+  read(magic, sizeof(magic));
+  read(&version, sizeof(version));
+  read(&byte_order, sizeof(byte_order));
+  if (!ok || memcmp(magic, MAGIC, sizeof(MAGIC)) || version != VERSION || byte_order != BYTE_ORDER) {
+    VSIFCloseL(f);
+    throw "Not a RasterIndex file or incompatible version";
+  }
+
+  read(&srs_count, sizeof(srs_count));
+  if (ok && srs_count > file_size / sizeof(uint32_t)) ok = false;
+  for (uint32_t i = 0; ok && i < srs_count; i++) {
+    std::string srs;
+    if (readString(srs) && i > 0) data->addSRS(srs);
+  }
+  read(&count, sizeof(count));
+  // An entry takes at least 7 doubles, the SRS, the path length and the order
+  const uint64_t min_entry_size = 7 * sizeof(double) + 3 * sizeof(uint32_t);
+  if (ok && (count > std::numeric_limits<uint32_t>::max() || count > file_size / min_entry_size)) ok = false;
+  std::vector<uint32_t> order;
+  if (ok) {
+    data->entries.resize(static_cast<size_t>(count));
+    for (Entry &e : data->entries) {
+      read(e.bounds, sizeof(e.bounds));
+      read(&e.res_x, sizeof(e.res_x));
+      read(&e.res_y, sizeof(e.res_y));
+      read(&e.time, sizeof(e.time));
+      read(&e.srs, sizeof(e.srs));
+      readString(e.path);
+      if (!ok) break;
+      if (e.srs >= data->srs_table.size()) ok = false;
+    }
+    order.resize(static_cast<size_t>(count));
+    read(order.data(), order.size() * sizeof(uint32_t));
+  }
+  VSIFCloseL(f);
+  if (!ok) throw "Truncated or corrupted index file";
+
+  std::vector<bool> seen(order.size());
+  for (uint32_t id : order) {
+    if (id >= order.size() || seen[id]) throw "Truncated or corrupted index file";
+    seen[id] = true;
+  }
+  data->build(&order);
+  return data;
+}
+
+// GDALDataset::GetSpatialRef() requires GDAL 3.0
+static std::shared_ptr<OGRSpatialReference> datasetSRS(GDALDataset *ds) {
+  const char *wkt = ds->GetProjectionRef();
+  if (wkt == nullptr || *wkt == '\0') return nullptr;
+  auto srs = std::make_shared<OGRSpatialReference>(wkt);
+#if GDAL_VERSION_MAJOR >= 3
+  srs->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+  return srs;
+}
+
+static std::string srsName(const OGRSpatialReference *srs) {
+  if (srs == nullptr) return "";
+  const char *auth = srs->GetAuthorityName(nullptr);
+  const char *code = srs->GetAuthorityCode(nullptr);
+  if (auth && code) return std::string(auth) + ":" + code;
+  char *wkt = nullptr;
+  srs->exportToWkt(&wkt);
+  std::string r = wkt ? wkt : "";
+  CPLFree(wkt);
+  return r;
+}
+
+static Local<Value> entryToObject(const RasterIndex::Data &data, uint32_t id) {
+  Nan::EscapableHandleScope scope;
+  const RasterIndex::Entry &e = data.entries[id];
+  Local<Object> obj = Nan::New<Object>();
+  Nan::Set(obj, Nan::New("id").ToLocalChecked(), Nan::New<Number>(id));
+  Nan::Set(obj, Nan::New("path").ToLocalChecked(), SafeString::New(e.path.c_str()));
+  Local<Object> bounds = Nan::New<Object>();
+  Nan::Set(bounds, Nan::New("minX").ToLocalChecked(), Nan::New<Number>(e.bounds[0]));
+  Nan::Set(bounds, Nan::New("minY").ToLocalChecked(), Nan::New<Number>(e.bounds[1]));
+  Nan::Set(bounds, Nan::New("maxX").ToLocalChecked(), Nan::New<Number>(e.bounds[2]));
+  Nan::Set(bounds, Nan::New("maxY").ToLocalChecked(), Nan::New<Number>(e.bounds[3]));
+  Nan::Set(obj, Nan::New("bounds").ToLocalChecked(), bounds);
+  Nan::Set(
+    obj,
+    Nan::New("srs").ToLocalChecked(),
+    e.srs ? SafeString::New(data.srs_table[e.srs].c_str()) : Nan::Null().As<Value>());
+  if (std::isnan(e.res_x) || std::isnan(e.res_y)) {
+    Nan::Set(obj, Nan::New("resolution").ToLocalChecked(), Nan::Null());
+  } else {
+    Local<Object> res = Nan::New<Object>();
+    Nan::Set(res, Nan::New("x").ToLocalChecked(), Nan::New<Number>(e.res_x));
+    Nan::Set(res, Nan::New("y").ToLocalChecked(), Nan::New<Number>(e.res_y));
+    Nan::Set(obj, Nan::New("resolution").ToLocalChecked(), res);
+  }
+  Nan::Set(
+    obj,
+    Nan::New("time").ToLocalChecked(),
+    std::isnan(e.time) ? Nan::Null().As<Value>() : Nan::New<Number>(e.time).As<Value>());
+  return scope.Escape(obj);
+}
+
+// Returns false if an exception has been thrown
+static bool timeFromValue(Local<Value> val, double &time) {
+  if (val->IsNull() || val->IsUndefined()) return true;
+  if (val->IsDate()) {
+    time = val.As<Date>()->ValueOf();
+    return true;
+  }
+  if (val->IsNumber()) {
+    time = Nan::To<double>(val).ToChecked();
+    return true;
+  }
+  Nan::ThrowTypeError("time must be a Date or a number of milliseconds");
+  return false;
+}
+
+// Accepts an Envelope or a point, returns false if an exception has been thrown
+static bool boxFromValue(Local<Value> val, double *box) {
+  if (!val->IsObject()) {
+    Nan::ThrowTypeError("Expected an object with minX, minY, maxX and maxY or with x and y");
+    return false;
+  }
+  Local<Object> obj = val.As<Object>();
+  static const char *const envelope[] = {"minX", "minY", "maxX", "maxY"};
+  static const char *const point[] = {"x", "y", "x", "y"};
+  const char *const *props = Nan::HasOwnProperty(obj, Nan::New("minX").ToLocalChecked()).FromMaybe(false) ||
+      Nan::Has(obj, Nan::New("minX").ToLocalChecked()).FromMaybe(false)
+    ? envelope
+    : point;
+  for (int i = 0; i < 4; i++) {
+    Local<Value> v = Nan::Get(obj, Nan::New(props[i]).ToLocalChecked()).ToLocalChecked();
+    if (!v->IsNumber()) {
+      Nan::ThrowTypeError("Expected an object with minX, minY, maxX and maxY or with x and y");
+      return false;
+    }
+    box[i] = Nan::To<double>(v).ToChecked();
+  }
+  if (box[0] > box[2] || box[1] > box[3]) {
+    Nan::ThrowRangeError("Invalid bounds");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @typedef {object} RasterIndexEntry
+ * @property {number} id Position of the entry in the index
+ * @property {string} path Path or URL of the raster
+ * @property {Envelope} bounds Footprint of the raster
+ * @property {string|null} srs SRS of the raster, as `AUTHORITY:CODE` when possible or as WKT
+ * @property {xyz|null} resolution Pixel size of the raster in its SRS
+ * @property {number|null} time Time of the raster in milliseconds since the epoch
+ */
+
+/**
+ * @typedef {object} RasterIndexEntryOptions
+ * @property {string} [srs] SRS of the raster
+ * @property {xyz} [resolution] Pixel size of the raster
+ * @property {Date|number} [time] Time of the raster
+ */
+
+/**
+ * Spatial index of the footprints of a collection of rasters.
+ *
+ * The footprints are stored in a static packed Hilbert R-tree that answers
+ * bounding box and point queries without going through OGR. The tree is rebuilt
+ * on the first query after the index has been modified.
+ *
+ * An index can be built from a list of files, from a tile index layer
+ * produced by `gdaltindex` or entry by entry, it can be saved to a compact
+ * binary file that can be loaded without rebuilding the tree.
+ *
+ * @example
+ * const index = await gdal.RasterIndex.fromFilesAsync(files)
+ * await index.saveAsync('tiles.idx')
+ * ...
+ * const index = await gdal.RasterIndex.loadAsync('tiles.idx')
+ * const tiles = index.search({ minX: 500000, minY: 4640000, maxX: 520000, maxY: 4660000 })
+ * const bands = tiles.map((t) => gdal.open(t.path).bands.get(1))
+ *
+ * @constructor
+ * @class RasterIndex
+ */
+NAN_METHOD(RasterIndex::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+  RasterIndex *index = new RasterIndex();
+  index->Wrap(info.This());
+  info.GetReturnValue().Set(info.This());
+}
+
+Local<Value> RasterIndex::New(std::shared_ptr<Data> data) {
+  Nan::EscapableHandleScope scope;
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(RasterIndex::constructor)).ToLocalChecked()).ToLocalChecked();
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(obj);
+  index->data = data;
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(RasterIndex::toString) {
+  info.GetReturnValue().Set(Nan::New("RasterIndex").ToLocalChecked());
+}
+
+/**
+ * Adds a raster to the index.
+ *
+ * @throws {Error}
+ * @method add
+ * @instance
+ * @memberof RasterIndex
+ * @param {string} path
+ * @param {Envelope} bounds
+ * @param {RasterIndexEntryOptions} [options]
+ * @return {number} The id of the new entry
+ */
+NAN_METHOD(RasterIndex::add) {
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(info.This());
+
+  Entry entry = {{0, 0, 0, 0}, NAN, NAN, NAN, 0, ""};
+  NODE_ARG_STR(0, "path", entry.path);
+  if (info.Length() < 2 || !boxFromValue(info[1], entry.bounds)) {
+    if (info.Length() < 2) Nan::ThrowError("bounds must be given");
+    return;
+  }
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+  std::string srs;
+  if (!options.IsEmpty()) {
+    NODE_STR_FROM_OBJ_OPT(options, "srs", srs);
+    Local<Value> res = Nan::Get(options, Nan::New("resolution").ToLocalChecked()).ToLocalChecked();
+    if (res->IsObject()) {
+      NODE_DOUBLE_FROM_OBJ(res.As<Object>(), "x", entry.res_x);
+      NODE_DOUBLE_FROM_OBJ(res.As<Object>(), "y", entry.res_y);
+    } else if (!res->IsUndefined() && !res->IsNull()) {
+      Nan::ThrowTypeError("resolution must be an object with x and y");
+      return;
+    }
+    if (!timeFromValue(Nan::Get(options, Nan::New("time").ToLocalChecked()).ToLocalChecked(), entry.time)) return;
+  }
+
+  // An async job may still be using the current data
+  if (index->data.use_count() > 1) index->data = std::make_shared<Data>(*index->data);
+  if (index->data->entries.size() >= std::numeric_limits<uint32_t>::max()) {
+    Nan::ThrowRangeError("Too many entries");
+    return;
+  }
+  entry.srs = index->data->addSRS(srs);
+  index->data->entries.push_back(entry);
+  index->data->indexed = false;
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(index->data->entries.size() - 1)));
+}
+
+/**
+ * Returns an entry by its id.
+ *
+ * @throws {Error}
+ * @method get
+ * @instance
+ * @memberof RasterIndex
+ * @param {number} id
+ * @return {RasterIndexEntry}
+ */
+NAN_METHOD(RasterIndex::get) {
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(info.This());
+  double id;
+  NODE_ARG_DOUBLE(0, "id", id);
+  if (id < 0 || id >= index->data->entries.size() || id != std::floor(id)) {
+    Nan::ThrowRangeError("Invalid id");
+    return;
+  }
+  info.GetReturnValue().Set(entryToObject(*index->data, static_cast<uint32_t>(id)));
+}
+
+/**
+ * @typedef {object} RasterIndexSearchOptions
+ * @property {Date|number} [from] Return only the rasters with a time after this one
+ * @property {Date|number} [to] Return only the rasters with a time before this one
+ */
+
+/**
+ * Returns the rasters whose footprints intersect a bounding box or contain a point.
+ *
+ * The results are in no particular order.
+ *
+ * @throws {Error}
+ * @method search
+ * @instance
+ * @memberof RasterIndex
+ * @param {Envelope|xyz} query
+ * @param {RasterIndexSearchOptions} [options]
+ * @return {RasterIndexEntry[]}
+ */
+NAN_METHOD(RasterIndex::search) {
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(info.This());
+
+  double box[4];
+  if (info.Length() < 1) {
+    Nan::ThrowError("query must be given");
+    return;
+  }
+  if (!boxFromValue(info[0], box)) return;
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  double from = NAN, to = NAN;
+  if (!options.IsEmpty()) {
+    if (!timeFromValue(Nan::Get(options, Nan::New("from").ToLocalChecked()).ToLocalChecked(), from)) return;
+    if (!timeFromValue(Nan::Get(options, Nan::New("to").ToLocalChecked()).ToLocalChecked(), to)) return;
+  }
+
+  Data &data = *index->data;
+  if (!data.indexed) data.build();
+  std::vector<uint32_t> ids;
+  data.search(box, ids);
+
+  Local<Array> results = Nan::New<Array>();
+  uint32_t n = 0;
+  for (uint32_t id : ids) {
+    double time = data.entries[id].time;
+    if (!std::isnan(from) && !(time >= from)) continue;
+    if (!std::isnan(to) && !(time <= to)) continue;
+    Nan::Set(results, n++, entryToObject(data, id));
+  }
+  info.GetReturnValue().Set(results);
+}
+
+/**
+ * Saves the index to a binary file.
+ *
+ * @throws {Error}
+ * @method save
+ * @instance
+ * @memberof RasterIndex
+ * @param {string} path
+ * @return {void}
+ */
+
+/**
+ * Saves the index to a binary file.
+ * @async
+ *
+ * @throws {Error}
+ * @method saveAsync
+ * @instance
+ * @memberof RasterIndex
+ * @param {string} path
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterIndex::save) {
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(info.This());
+  std::string path;
+  NODE_ARG_STR(0, "path", path);
+
+  // The tree is built here so that the job does not modify the data
+  if (!index->data->indexed) index->data->build();
+  std::shared_ptr<const Data> data = index->data;
+
+  GDALAsyncableJob<int> job(0);
+  job.main = [data, path](const GDALExecutionProgress &) {
+    data->save(path);
+    return 0;
+  };
+  job.rval = [](int, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Loads an index saved with {@link RasterIndex.save}.
+ *
+ * @throws {Error}
+ * @method load
+ * @static
+ * @memberof RasterIndex
+ * @param {string} path
+ * @return {RasterIndex}
+ */
+
+/**
+ * Loads an index saved with {@link RasterIndex.save}.
+ * @async
+ *
+ * @throws {Error}
+ * @method loadAsync
+ * @static
+ * @memberof RasterIndex
+ * @param {string} path
+ * @param {callback<RasterIndex>} [callback=undefined]
+ * @return {Promise<RasterIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterIndex::load) {
+  std::string path;
+  NODE_ARG_STR(0, "path", path);
+
+  GDALAsyncableJob<std::shared_ptr<Data>> job(0);
+  job.main = [path](const GDALExecutionProgress &) { return Data::load(path); };
+  job.rval = [](std::shared_ptr<Data> data, const GetFromPersistentFunc &) { return RasterIndex::New(data); };
+  job.run(info, async, 1);
+}
+
+/**
+ * @typedef {object} RasterIndexFilesOptions
+ * @property {SpatialReference} [srs] Transform the footprints to this SRS, requires GDAL 3.4
+ * @property {number} [threads=2] Maximum number of files opened in parallel
+ */
+
+/**
+ * Builds an index from a list of raster files.
+ *
+ * Only the headers of the files are read, several files are opened in parallel.
+ * The footprints are in the SRS of each file unless `srs` is specified.
+ *
+ * @throws {Error}
+ * @method fromFiles
+ * @static
+ * @memberof RasterIndex
+ * @param {string[]} paths
+ * @param {RasterIndexFilesOptions} [options]
+ * @return {RasterIndex}
+ */
+
+/**
+ * Builds an index from a list of raster files.
+ * @async
+ *
+ * Only the headers of the files are read, several files are opened in parallel.
+ * The footprints are in the SRS of each file unless `srs` is specified.
+ *
+ * @throws {Error}
+ * @method fromFilesAsync
+ * @static
+ * @memberof RasterIndex
+ * @param {string[]} paths
+ * @param {RasterIndexFilesOptions} [options]
+ * @param {callback<RasterIndex>} [callback=undefined]
+ * @return {Promise<RasterIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterIndex::fromFiles) {
+  Local<Array> paths_array;
+  NODE_ARG_ARRAY(0, "paths", paths_array);
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+
+  auto paths = std::make_shared<std::vector<std::string>>();
+  for (unsigned i = 0; i < paths_array->Length(); i++) {
+    Local<Value> val = Nan::Get(paths_array, i).ToLocalChecked();
+    if (!val->IsString()) {
+      Nan::ThrowTypeError("paths must be an array of strings");
+      return;
+    }
+    paths->push_back(*Nan::Utf8String(val));
+  }
+
+  // The jobs themselves already run in parallel on the libuv thread pool
+  int threads = 2;
+  std::shared_ptr<OGRSpatialReference> target;
+  if (!options.IsEmpty()) {
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+    SpatialReference *srs = nullptr;
+    NODE_WRAPPED_FROM_OBJ_OPT(options, "srs", SpatialReference, srs);
+    if (srs) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 4)
+      target = std::shared_ptr<OGRSpatialReference>(srs->get()->Clone());
+      target->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#else
+      Nan::ThrowError("srs requires GDAL 3.4");
+      return;
+#endif
+    }
+  }
+  threads = std::max(threads, 1);
+
+  GDALAsyncableJob<std::shared_ptr<Data>> job(0);
+  job.main = [paths, threads, target](const GDALExecutionProgress &) {
+    const size_t n = paths->size();
+    if (n >= std::numeric_limits<uint32_t>::max()) throw "Too many entries";
+    auto data = std::make_shared<Data>();
+    data->entries.resize(n);
+    std::vector<std::string> srs_names(n);
+
+    std::atomic<size_t> next(0);
+    std::mutex error_lock;
+    std::string error;
+    auto worker = [&]() {
+      size_t i;
+      while ((i = next++) < n) {
+        const std::string &path = (*paths)[i];
+        Entry &e = data->entries[i];
+        e.path = path;
+        std::string failure;
+        CPLErrorReset();
+        GDALDataset *ds =
+          static_cast<GDALDataset *>(GDALOpenEx(path.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, NULL, NULL, NULL));
+        double gt[6];
+        if (!ds) {
+          failure = std::string("Failed opening ") + path + ": " + CPLGetLastErrorMsg();
+        } else if (ds->GetGeoTransform(gt) != CE_None) {
+          failure = path + " has no geotransform";
+        } else {
+          int x = ds->GetRasterXSize(), y = ds->GetRasterYSize();
+          double xs[] = {gt[0], gt[0] + gt[1] * x, gt[0] + gt[2] * y, gt[0] + gt[1] * x + gt[2] * y};
+          double ys[] = {gt[3], gt[3] + gt[4] * x, gt[3] + gt[5] * y, gt[3] + gt[4] * x + gt[5] * y};
+          e.bounds[0] = *std::min_element(xs, xs + 4);
+          e.bounds[1] = *std::min_element(ys, ys + 4);
+          e.bounds[2] = *std::max_element(xs, xs + 4);
+          e.bounds[3] = *std::max_element(ys, ys + 4);
+          e.res_x = std::hypot(gt[1], gt[4]);
+          e.res_y = std::hypot(gt[2], gt[5]);
+          e.time = NAN;
+          std::shared_ptr<OGRSpatialReference> srs = datasetSRS(ds);
+          srs_names[i] = srsName(srs.get());
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 4)
+          if (target) {
+            std::unique_ptr<OGRCoordinateTransformation> ct(
+              srs ? OGRCreateCoordinateTransformation(srs.get(), target.get()) : nullptr);
+            double b[4];
+            if (!ct) {
+              failure = path + " cannot be transformed to the target SRS";
+            } else if (!ct->TransformBounds(
+                         e.bounds[0], e.bounds[1], e.bounds[2], e.bounds[3], &b[0], &b[1], &b[2], &b[3], 21)) {
+              failure = std::string("Failed transforming the footprint of ") + path;
+            } else {
+              memcpy(e.bounds, b, sizeof(b));
+            }
+          }
+#endif
+        }
+        if (ds) GDALClose(ds);
+        if (!failure.empty()) {
+          std::lock_guard<std::mutex> lock(error_lock);
+          if (error.empty()) error = failure;
+          return;
+        }
+      }
+    };
+
+    size_t n_threads = std::min(n, static_cast<size_t>(threads));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < n_threads; t++) workers.emplace_back(worker);
+    worker();
+    for (auto &w : workers) w.join();
+
+    if (!error.empty()) {
+      CPLError(CE_Failure, CPLE_AppDefined, "%s", error.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    for (size_t i = 0; i < n; i++) data->entries[i].srs = data->addSRS(srs_names[i]);
+    data->build();
+    return data;
+  };
+  job.rval = [](std::shared_ptr<Data> data, const GetFromPersistentFunc &) { return RasterIndex::New(data); };
+  job.run(info, async, 2);
+}
+
+// Date and DateTime fields in milliseconds since the epoch
+static double fieldTime(OGRFeature *feature, int field) {
+  switch (feature->GetFieldDefnRef(field)->GetType()) {
+    case OFTDate:
+    case OFTDateTime: {
+      int year, month, day, hour, minute, tz;
+      float second;
+      if (!feature->GetFieldAsDateTime(field, &year, &month, &day, &hour, &minute, &second, &tz)) return NAN;
+      struct tm t;
+      memset(&t, 0, sizeof(t));
+      t.tm_year = year - 1900;
+      t.tm_mon = month - 1;
+      t.tm_mday = day;
+      t.tm_hour = hour;
+      t.tm_min = minute;
+      double ms = static_cast<double>(CPLYMDHMSToUnixTime(&t)) * 1000 + static_cast<double>(second) * 1000;
+      // 100 is UTC, every step is 15 minutes
+      if (tz > 1) ms -= (tz - 100) * 15 * 60 * 1000.0;
+      return ms;
+    }
+    case OFTInteger:
+    case OFTInteger64:
+    case OFTReal: return feature->GetFieldAsDouble(field);
+    default: return NAN;
+  }
+}
+
+/**
+ * @typedef {object} RasterIndexLayerOptions
+ * @property {string} [locationField="location"] Field with the path of the raster
+ * @property {string} [srsField] Field with the SRS of the raster (`gdaltindex -src_srs_name`), the SRS of the layer by default
+ * @property {string} [timeField] Date, DateTime or numeric (milliseconds since the epoch) field with the time of the raster
+ */
+
+/**
+ * Builds an index from a tile index layer such as the ones produced by `gdaltindex`.
+ *
+ * The features are read in a single operation, the spatial and the attribute
+ * filters of the layer are honored.
+ *
+ * @throws {Error}
+ * @method fromLayer
+ * @static
+ * @memberof RasterIndex
+ * @param {Layer} layer
+ * @param {RasterIndexLayerOptions} [options]
+ * @return {RasterIndex}
+ */
+
+/**
+ * Builds an index from a tile index layer such as the ones produced by `gdaltindex`.
+ * @async
+ *
+ * The features are read in a single operation, the spatial and the attribute
+ * filters of the layer are honored.
+ *
+ * @throws {Error}
+ * @method fromLayerAsync
+ * @static
+ * @memberof RasterIndex
+ * @param {Layer} layer
+ * @param {RasterIndexLayerOptions} [options]
+ * @param {callback<RasterIndex>} [callback=undefined]
+ * @return {Promise<RasterIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterIndex::fromLayer) {
+  Layer *layer;
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+
+  std::string location_field = "location", srs_field, time_field;
+  if (!options.IsEmpty()) {
+    NODE_STR_FROM_OBJ_OPT(options, "locationField", location_field);
+    NODE_STR_FROM_OBJ_OPT(options, "srsField", srs_field);
+    NODE_STR_FROM_OBJ_OPT(options, "timeField", time_field);
+  }
+
+  OGRLayer *raw = layer->get();
+  GDALAsyncableJob<std::shared_ptr<Data>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [raw, location_field, srs_field, time_field](const GDALExecutionProgress &) {
+    OGRFeatureDefn *defn = raw->GetLayerDefn();
+    int location = defn->GetFieldIndex(location_field.c_str());
+    if (location < 0) throw "Location field not found";
+    int srs = -1, time = -1;
+    if (!srs_field.empty() && (srs = defn->GetFieldIndex(srs_field.c_str())) < 0) throw "SRS field not found";
+    if (!time_field.empty() && (time = defn->GetFieldIndex(time_field.c_str())) < 0) throw "Time field not found";
+
+    auto data = std::make_shared<Data>();
+    uint32_t layer_srs = data->addSRS(srsName(raw->GetSpatialRef()));
+    raw->ResetReading();
+    OGRFeature *next;
+    while ((next = raw->GetNextFeature()) != nullptr) {
+      // OGRFeatureUniquePtr requires GDAL 2.3
+      std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> feature(next, OGRFeature::DestroyFeature);
+      OGRGeometry *geom = feature->GetGeometryRef();
+      if (geom == nullptr || geom->IsEmpty() || !feature->IsFieldSetAndNotNull(location)) continue;
+      if (data->entries.size() >= std::numeric_limits<uint32_t>::max()) throw "Too many entries";
+      OGREnvelope env;
+      geom->getEnvelope(&env);
+      Entry e = {
+        {env.MinX, env.MinY, env.MaxX, env.MaxY}, NAN, NAN, NAN, layer_srs, feature->GetFieldAsString(location)};
+      if (srs >= 0 && feature->IsFieldSetAndNotNull(srs)) e.srs = data->addSRS(feature->GetFieldAsString(srs));
+      if (time >= 0 && feature->IsFieldSetAndNotNull(time)) e.time = fieldTime(feature.get(), time);
+      data->entries.push_back(e);
+    }
+    raw->ResetReading();
+    data->build();
+    return data;
+  };
+  job.rval = [](std::shared_ptr<Data> data, const GetFromPersistentFunc &) { return RasterIndex::New(data); };
+  job.run(info, async, 2);
+}
+
+/**
+ * @readonly
+ * @kind member
+ * @name count
+ * @instance
+ * @memberof RasterIndex
+ * @type {number}
+ */
+NAN_GETTER(RasterIndex::countGetter) {
+  RasterIndex *index = Nan::ObjectWrap::Unwrap<RasterIndex>(info.This());
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(index->data->entries.size())));
+}
+
+} // namespace node_gdal
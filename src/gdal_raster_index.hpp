@@ -0,0 +1,87 @@
+#ifndef __NODE_GDAL_RASTER_INDEX_H__
+#define __NODE_GDAL_RASTER_INDEX_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "async.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+// Footprints of a collection of rasters in a static packed Hilbert R-tree
+class RasterIndex : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static NAN_METHOD(toString);
+  static NAN_METHOD(add);
+  static NAN_METHOD(get);
+  static NAN_METHOD(search);
+  GDAL_ASYNCABLE_DECLARE(save);
+  GDAL_ASYNCABLE_DECLARE(load);
+  GDAL_ASYNCABLE_DECLARE(fromFiles);
+  GDAL_ASYNCABLE_DECLARE(fromLayer);
+
+  static NAN_GETTER(countGetter);
+
+  struct Entry {
+    // minX, minY, maxX, maxY
+    double bounds[4];
+    double res_x, res_y;
+    // ms since the epoch, NaN if unknown
+    double time;
+    // index in srs_table, 0 is unknown
+    uint32_t srs;
+    std::string path;
+  };
+
+  // Shared with the async jobs, it is copied by the main thread
+  // before being modified if a job is still holding it
+  struct Data {
+    std::vector<Entry> entries;
+    std::vector<std::string> srs_table;
+    std::unordered_map<std::string, uint32_t> srs_lookup;
+
+    // The packed tree, the first level are the entries
+    // sorted by the Hilbert value of their centers
+    bool indexed;
+    std::vector<std::array<double, 4>> boxes;
+    std::vector<uint32_t> index;
+    std::vector<size_t> level_end;
+
+    Data();
+    uint32_t addSRS(const std::string &srs);
+    void build(const std::vector<uint32_t> *order = nullptr);
+    void search(const double *box, std::vector<uint32_t> &result) const;
+    // throw const char *
+    void save(const std::string &path) const;
+    static std::shared_ptr<Data> load(const std::string &path);
+  };
+
+  static Local<Value> New(std::shared_ptr<Data> data);
+
+    private:
+  RasterIndex();
+  ~RasterIndex();
+  std::shared_ptr<Data> data;
+};
+
+} // namespace node_gdal
+#endif
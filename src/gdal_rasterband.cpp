@@ -12,7 +12,6 @@
 
 #include <cpl_port.h>
 #include <limits>
-#include <mutex>
 
 namespace node_gdal {
 
@@ -39,6 +38,9 @@ void RasterBand::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "createMaskBand", createMaskBand);
   Nan__SetPrototypeAsyncableMethod(lcons, "getMetadata", getMetadata);
   Nan__SetPrototypeAsyncableMethod(lcons, "setMetadata", setMetadata);
+  Nan__SetPrototypeAsyncableMethod(lcons, "getCacheUsage", getCacheUsage);
+  Nan__SetPrototypeAsyncableMethod(lcons, "getDataCoverage", getDataCoverage);
+  Nan__SetPrototypeAsyncableMethod(lcons, "adviseRead", adviseRead);
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
   ATTR_ASYNCABLE(lcons, "id", idGetter, READ_ONLY_SETTER);
@@ -65,11 +67,11 @@ void RasterBand::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-RasterBand::RasterBand(GDALRasterBand *band) : Nan::ObjectWrap(), uid(0), this_(band), parent_ds(0) {
+RasterBand::RasterBand(GDALRasterBand *band) : Nan::ObjectWrap(), uid(0), snapshot(), this_(band), parent_ds(0) {
   LOG("Created band [%p] (dataset = %p)", band, band->GetDataset());
 }
 
-RasterBand::RasterBand() : Nan::ObjectWrap(), uid(0), this_(0), parent_ds(0) {
+RasterBand::RasterBand() : Nan::ObjectWrap(), uid(0), snapshot(), this_(0), parent_ds(0) {
 }
 
 RasterBand::~RasterBand() {
@@ -153,6 +155,24 @@ Local<Value> RasterBand::New(GDALRasterBand *raw, GDALDataset *raw_parent) {
   wrapped->parent_uid = parent_uid;
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
+  if (parent->snapshot.valid) {
+    // These are simple field accessors that are safe to call
+    // even if another thread is holding the Dataset lock
+    wrapped->snapshot.x = raw->GetXSize();
+    wrapped->snapshot.y = raw->GetYSize();
+    raw->GetBlockSize(&wrapped->snapshot.block_x, &wrapped->snapshot.block_y);
+    wrapped->snapshot.type = raw->GetRasterDataType();
+    // The no data value might need I/O, it was read with the Dataset
+    // (overviews and masks are not numbered)
+    int n = raw->GetBand();
+    if (n > 0 && n <= static_cast<int>(parent->snapshot.nodata.size()) && raw_parent->GetRasterBand(n) == raw) {
+      wrapped->snapshot.nodata = parent->snapshot.nodata[n - 1];
+      wrapped->snapshot.has_nodata = parent->snapshot.has_nodata[n - 1];
+      wrapped->snapshot.nodata_valid = true;
+    }
+    wrapped->snapshot.valid = true;
+  }
+
   return scope.Escape(obj);
 }
 
@@ -288,21 +308,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBand::fill) {
 
 // --- Custom error handling to handle VRT errors ---
 // see: https://github.com/mapbox/mapnik-omnivore/issues/10
-
-std::mutex stats_lock;
-std::string stats_file_err = "";
-CPLErrorHandler last_err_handler;
-void CPL_STDCALL statisticsErrorHandler(CPLErr eErrClass, int err_no, const char *msg) {
-  if (err_no == CPLE_OpenFailed) { stats_file_err = msg; }
-  if (last_err_handler) { last_err_handler(eErrClass, err_no, msg); }
-}
-void pushStatsErrorHandler() {
-  last_err_handler = CPLSetErrorHandler(statisticsErrorHandler);
-}
-void popStatsErrorHandler() {
-  if (!last_err_handler) return;
-  CPLSetErrorHandler(last_err_handler);
-}
+// GDALErrorCapture is thread-local, so the statistics of different bands can be computed in parallel
 
 /**
  * Return a view of this raster band as a 2D multidimensional GDALMDArray.
@@ -361,11 +367,17 @@ NAN_METHOD(RasterBand::getStatistics) {
   NODE_ARG_BOOL(1, "force", force);
   NODE_UNWRAP_CHECK(RasterBand, info.This(), band);
   GDAL_LOCK_PARENT(band);
-  pushStatsErrorHandler();
-  CPLErr err = band->this_->GetStatistics(approx, force, &min, &max, &mean, &std_dev);
-  popStatsErrorHandler();
-  if (!stats_file_err.empty()) {
-    Nan::ThrowError(stats_file_err.c_str());
+  std::string file_err;
+  CPLErr err;
+  {
+    GDALErrorCapture errors(true);
+    err = band->this_->GetStatistics(approx, force, &min, &max, &mean, &std_dev);
+    const GDALErrorRecord *open_failed = errors.find(CPLE_OpenFailed);
+    if (open_failed != nullptr) file_err = open_failed->message;
+  }
+  if (!file_err.empty()) {
+    Nan::ThrowError(file_err.c_str());
+    return;
   } else if (err) {
     if (!force && err == CE_Warning) {
       Nan::ThrowError("Statistics cannot be efficiently computed without scanning raster");
@@ -444,14 +456,18 @@ GDAL_ASYNCABLE_DEFINE(RasterBand::computeStatistics) {
 
   job.main = [gdal_obj, approx](const GDALExecutionProgress &) {
     struct stats_t stats;
-    std::lock_guard<std::mutex> guard(stats_lock);
+    std::string file_err;
+    CPLErr err;
 
     CPLErrorReset();
-    pushStatsErrorHandler();
-    CPLErr err = gdal_obj->ComputeStatistics(approx, &stats.min, &stats.max, &stats.mean, &stats.std_dev, NULL, NULL);
-    popStatsErrorHandler();
-    if (!stats_file_err.empty()) {
-      throw stats_file_err.c_str();
+    {
+      GDALErrorCapture errors(true);
+      err = gdal_obj->ComputeStatistics(approx, &stats.min, &stats.max, &stats.mean, &stats.std_dev, NULL, NULL);
+      const GDALErrorRecord *open_failed = errors.find(CPLE_OpenFailed);
+      if (open_failed != nullptr) file_err = open_failed->message;
+    }
+    if (!file_err.empty()) {
+      throw CPLSPrintf("%s", file_err.c_str());
     } else if (err != CPLE_None) {
       throw CPLGetLastErrorMsg();
     }
@@ -539,6 +555,262 @@ GDAL_ASYNCABLE_DEFINE(RasterBand::getMetadata) {
   job.run(info, async, 1);
 }
 
+/**
+ * @typedef {object} BandCacheUsage
+ * @memberof RasterBand
+ * @property {number} blocks Number of blocks in the block cache
+ * @property {number} dirty Number of modified blocks not yet written
+ * @property {number} bytes Memory used by these blocks
+ */
+
+/**
+ * Returns the usage of the GDAL block cache by this band.
+ *
+ * Looks up every block of the band, this can be expensive for very large rasters.
+ *
+ * @method getCacheUsage
+ * @instance
+ * @memberof RasterBand
+ * @return {BandCacheUsage}
+ */
+
+/**
+ * Returns the usage of the GDAL block cache by this band.
+ * @async
+ *
+ * Looks up every block of the band, this can be expensive for very large rasters.
+ *
+ * @method getCacheUsageAsync
+ * @instance
+ * @memberof RasterBand
+ * @param {callback<BandCacheUsage>} [callback=undefined]
+ * @return {Promise<BandCacheUsage>}
+ */
+struct BandCacheUsage {
+  int64_t blocks;
+  int64_t dirty;
+  int64_t bytes;
+};
+
+GDAL_ASYNCABLE_DEFINE(RasterBand::getCacheUsage) {
+  NODE_UNWRAP_CHECK(RasterBand, info.This(), band);
+  GDAL_RAW_CHECK(GDALRasterBand *, band, raw);
+
+  GDALAsyncableJob<BandCacheUsage> job(band->parent_uid);
+  job.main = [raw](const GDALExecutionProgress &) {
+    BandCacheUsage usage = {0, 0, 0};
+    int block_w, block_h;
+    raw->GetBlockSize(&block_w, &block_h);
+    if (block_w <= 0 || block_h <= 0) return usage;
+    int blocks_x = (raw->GetXSize() + block_w - 1) / block_w;
+    int blocks_y = (raw->GetYSize() + block_h - 1) / block_h;
+    for (int y = 0; y < blocks_y; y++) {
+      for (int x = 0; x < blocks_x; x++) {
+        GDALRasterBlock *block = raw->TryGetLockedBlockRef(x, y);
+        if (block == nullptr) continue;
+        usage.blocks++;
+        if (block->GetDirty()) usage.dirty++;
+        usage.bytes += block->GetBlockSize();
+        block->DropLock();
+      }
+    }
+    return usage;
+  };
+  job.rval = [](BandCacheUsage usage, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("blocks").ToLocalChecked(), Nan::New<Number>(static_cast<double>(usage.blocks)));
+    Nan::Set(result, Nan::New("dirty").ToLocalChecked(), Nan::New<Number>(static_cast<double>(usage.dirty)));
+    Nan::Set(result, Nan::New("bytes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(usage.bytes)));
+    return scope.Escape(result);
+  };
+  job.run(info, async, 0);
+}
+
+/**
+ * @typedef {object} DataCoverage
+ * @memberof RasterBand
+ * @property {boolean} data There is (potentially) data in the window
+ * @property {boolean} empty There are empty regions in the window, typically missing blocks
+ * @property {boolean} unimplemented The driver does not implement the data coverage, the window is reported as data
+ * @property {number} percent Percentage of the window covered by data, `-1` if unknown
+ */
+
+/**
+ * Returns the data coverage of a window of the band without reading its pixels.
+ *
+ * Formats supporting sparse files (GTiff, VRT mosaics, some tiled formats)
+ * report the regions without data, allowing to skip them. A window
+ * that is entirely `empty` and has no `data` can be considered filled with nodata.
+ *
+ * @method getDataCoverage
+ * @instance
+ * @memberof RasterBand
+ * @param {number} [x=0]
+ * @param {number} [y=0]
+ * @param {number} [width=rasterSize.x-x]
+ * @param {number} [height=rasterSize.y-y]
+ * @return {DataCoverage}
+ */
+
+/**
+ * Returns the data coverage of a window of the band without reading its pixels.
+ * @async
+ *
+ * Formats supporting sparse files (GTiff, VRT mosaics, some tiled formats)
+ * report the regions without data, allowing to skip them. A window
+ * that is entirely `empty` and has no `data` can be considered filled with nodata.
+ *
+ * @method getDataCoverageAsync
+ * @instance
+ * @memberof RasterBand
+ * @param {number} [x=0]
+ * @param {number} [y=0]
+ * @param {number} [width=rasterSize.x-x]
+ * @param {number} [height=rasterSize.y-y]
+ * @param {callback<DataCoverage>} [callback=undefined]
+ * @return {Promise<DataCoverage>}
+ */
+struct DataCoverage {
+  int status;
+  double percent;
+};
+
+GDAL_ASYNCABLE_DEFINE(RasterBand::getDataCoverage) {
+  int x = 0, y = 0, w = -1, h = -1;
+  NODE_ARG_INT_OPT(0, "x", x);
+  NODE_ARG_INT_OPT(1, "y", y);
+  NODE_ARG_INT_OPT(2, "width", w);
+  NODE_ARG_INT_OPT(3, "height", h);
+  NODE_UNWRAP_CHECK(RasterBand, info.This(), band);
+  GDAL_RAW_CHECK(GDALRasterBand *, band, raw);
+
+  GDALAsyncableJob<DataCoverage> job(band->parent_uid);
+  job.main = [raw, x, y, w, h](const GDALExecutionProgress &) {
+    int width = w < 0 ? raw->GetXSize() - x : w;
+    int height = h < 0 ? raw->GetYSize() - y : h;
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > raw->GetXSize() ||
+        y + height > raw->GetYSize())
+      throw "Invalid window";
+    DataCoverage r = {0, -1};
+    r.status = raw->GetDataCoverageStatus(x, y, width, height, 0, &r.percent);
+    return r;
+  };
+  job.rval = [](DataCoverage r, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(
+      result,
+      Nan::New("data").ToLocalChecked(),
+      Nan::New<Boolean>((r.status & GDAL_DATA_COVERAGE_STATUS_DATA) != 0));
+    Nan::Set(
+      result,
+      Nan::New("empty").ToLocalChecked(),
+      Nan::New<Boolean>((r.status & GDAL_DATA_COVERAGE_STATUS_EMPTY) != 0));
+    Nan::Set(
+      result,
+      Nan::New("unimplemented").ToLocalChecked(),
+      Nan::New<Boolean>((r.status & GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED) != 0));
+    Nan::Set(result, Nan::New("percent").ToLocalChecked(), Nan::New<Number>(r.percent));
+    return scope.Escape(result);
+  };
+  job.run(info, async, 4);
+}
+
+/**
+ * @typedef {object} AdviseReadOptions
+ * @property {number} [buffer_width=width] Width of the buffer that will be read
+ * @property {number} [buffer_height=height] Height of the buffer that will be read
+ * @property {string} [data_type] Data type of the buffer that will be read, the band data type by default
+ */
+
+/**
+ * Advises the driver that a window will be read soon.
+ *
+ * Drivers that support it (JP2OpenJPEG, ECW, some network-backed formats) can
+ * start fetching the data in the background or read it with fewer requests,
+ * the other drivers ignore it.
+ *
+ * @method adviseRead
+ * @instance
+ * @memberof RasterBand
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {AdviseReadOptions} [options]
+ * @return {void}
+ */
+
+/**
+ * Advises the driver that a window will be read soon.
+ * @async
+ *
+ * Drivers that support it (JP2OpenJPEG, ECW, some network-backed formats) can
+ * start fetching the data in the background or read it with fewer requests,
+ * the other drivers ignore it.
+ *
+ * @method adviseReadAsync
+ * @instance
+ * @memberof RasterBand
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {AdviseReadOptions} [options]
+ * @param {callback<void>} [callback=undefined]
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterBand::adviseRead) {
+  int x, y, w, h;
+  NODE_ARG_INT(0, "x", x);
+  NODE_ARG_INT(1, "y", y);
+  NODE_ARG_INT(2, "width", w);
+  NODE_ARG_INT(3, "height", h);
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(4, "options", options);
+  int buffer_w = w, buffer_h = h;
+  std::string type_name;
+  if (!options.IsEmpty()) {
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_width", buffer_w);
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_height", buffer_h);
+    NODE_STR_FROM_OBJ_OPT(options, "data_type", type_name);
+  }
+  GDALDataType type = GDT_Unknown;
+  if (!type_name.empty()) {
+    type = GDALGetDataTypeByName(type_name.c_str());
+    if (type == GDT_Unknown) {
+      Nan::ThrowError("Invalid GDAL data type");
+      return;
+    }
+  }
+
+  NODE_UNWRAP_CHECK(RasterBand, info.This(), band);
+  GDAL_RAW_CHECK(GDALRasterBand *, band, raw);
+
+  // The size of a band is a simple field accessor, safe to call
+  // even if another thread is holding the Dataset lock
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x > raw->GetXSize() - w || y > raw->GetYSize() - h) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+  if (buffer_w <= 0 || buffer_h <= 0) {
+    Nan::ThrowRangeError("Invalid buffer size");
+    return;
+  }
+
+  GDALAsyncableJob<CPLErr> job(band->parent_uid);
+  job.main = [raw, x, y, w, h, buffer_w, buffer_h, type](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    CPLErr err = raw->AdviseRead(
+      x, y, w, h, buffer_w, buffer_h, type == GDT_Unknown ? raw->GetRasterDataType() : type, nullptr);
+    if (err) { throw CPLGetLastErrorMsg(); }
+    return err;
+  };
+  job.rval = [](CPLErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 5);
+}
+
 /**
  * Set metadata. Can return a warning (false) for formats not supporting persistent metadata.
  *
@@ -714,6 +986,14 @@ GDAL_ASYNCABLE_GETTER_DEFINE(RasterBand::sizeGetter) {
   NODE_UNWRAP_CHECK_ASYNC(RasterBand, info.This(), band);
   GDAL_RAW_CHECK_ASYNC(GDALRasterBand *, band, raw);
 
+  if (!async && band->snapshot.valid) {
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(band->snapshot.x));
+    Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(band->snapshot.y));
+    info.GetReturnValue().Set(result);
+    return;
+  }
+
   struct xy {
     int x, y;
   };
@@ -760,6 +1040,14 @@ GDAL_ASYNCABLE_GETTER_DEFINE(RasterBand::blockSizeGetter) {
   NODE_UNWRAP_CHECK_ASYNC(RasterBand, info.This(), band);
   GDAL_RAW_CHECK_ASYNC(GDALRasterBand *, band, raw);
 
+  if (!async && band->snapshot.valid) {
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(band->snapshot.block_x));
+    Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(band->snapshot.block_y));
+    info.GetReturnValue().Set(result);
+    return;
+  }
+
   struct xy {
     int x, y;
   };
@@ -967,6 +1255,14 @@ GDAL_ASYNCABLE_GETTER_DEFINE(RasterBand::noDataValueGetter) {
   NODE_UNWRAP_CHECK_ASYNC(RasterBand, info.This(), band);
   GDAL_RAW_CHECK_ASYNC(GDALRasterBand *, band, raw);
 
+  if (!async && band->snapshot.valid && band->snapshot.nodata_valid) {
+    if (band->snapshot.has_nodata)
+      info.GetReturnValue().Set(Nan::New<Number>(band->snapshot.nodata));
+    else
+      info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
   GDALAsyncableJob<MaybeResult<double>> job(band->parent_uid);
   job.main = [raw](const GDALExecutionProgress &) {
     MaybeResult<double> r;
@@ -1051,6 +1347,14 @@ GDAL_ASYNCABLE_GETTER_DEFINE(RasterBand::dataTypeGetter) {
   NODE_UNWRAP_CHECK_ASYNC(RasterBand, info.This(), band);
   GDAL_RAW_CHECK_ASYNC(GDALRasterBand *, band, raw);
 
+  if (!async && band->snapshot.valid) {
+    if (band->snapshot.type == GDT_Unknown)
+      info.GetReturnValue().Set(Nan::Null());
+    else
+      info.GetReturnValue().Set(SafeString::New(GDALGetDataTypeName(band->snapshot.type)));
+    return;
+  }
+
   GDALAsyncableJob<GDALDataType> job(band->parent_uid);
   job.main = [raw](const GDALExecutionProgress &) {
     CPLErrorReset();
@@ -1258,7 +1562,24 @@ NAN_SETTER(RasterBand::noDataValueSetter) {
     return;
   }
 
-  if (err != CE_None) { NODE_THROW_LAST_CPLERR; }
+  if (err != CE_None) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+  // Some drivers (PAM) allow this on read-only datasets
+  if (band->snapshot.valid) {
+    band->snapshot.nodata = band->this_->GetNoDataValue(&band->snapshot.has_nodata);
+    band->snapshot.nodata_valid = true;
+    // The next wrapper of this band will be created from the Dataset snapshot
+    int n = band->this_->GetBand();
+    if (object_store.has(band->parent_ds)) {
+      Dataset *parent = Nan::ObjectWrap::Unwrap<Dataset>(object_store.get(band->parent_ds));
+      if (n > 0 && n <= static_cast<int>(parent->snapshot.nodata.size())) {
+        parent->snapshot.nodata[n - 1] = band->snapshot.nodata;
+        parent->snapshot.has_nodata[n - 1] = band->snapshot.has_nodata;
+      }
+    }
+  }
 }
 
 NAN_SETTER(RasterBand::scaleSetter) {
@@ -38,6 +38,9 @@ class RasterBand : public Nan::ObjectWrap {
   static NAN_METHOD(createMaskBand);
   GDAL_ASYNCABLE_DECLARE(getMetadata);
   GDAL_ASYNCABLE_DECLARE(setMetadata);
+  GDAL_ASYNCABLE_DECLARE(getCacheUsage);
+  GDAL_ASYNCABLE_DECLARE(getDataCoverage);
+  GDAL_ASYNCABLE_DECLARE(adviseRead);
   static NAN_GETTER(dsGetter);
   GDAL_ASYNCABLE_GETTER_DECLARE(sizeGetter);
   GDAL_ASYNCABLE_GETTER_DECLARE(idGetter);
@@ -83,6 +86,18 @@ class RasterBand : public Nan::ObjectWrap {
   // Dataset that will be locked
   long parent_uid;
 
+  // Immutable properties of bands of read-only datasets captured on creation
+  // The sync getters return them without acquiring the Dataset lock
+  struct Snapshot {
+    bool valid;
+    int x, y;
+    int block_x, block_y;
+    GDALDataType type;
+    bool nodata_valid;
+    int has_nodata;
+    double nodata;
+  } snapshot;
+
     private:
   ~RasterBand();
   GDALRasterBand *this_;
@@ -0,0 +1,613 @@
+#include "gdal_vrt_builder.hpp"
+#include "gdal_common.hpp"
+#include "gdal_dataset.hpp"
+#include "gdal_rasterband.hpp"
+#include "gdal_spatial_reference.hpp"
+#include "utils/string_list.hpp"
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 5)
+
+#include <vrtdataset.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> VRTBuilder::constructor;
+
+void VRTBuilder::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(VRTBuilder::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("VRTBuilder").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "addBand", addBand);
+  Nan::SetPrototypeMethod(lcons, "addSimpleSource", addSimpleSource);
+  Nan::SetPrototypeMethod(lcons, "addComplexSource", addComplexSource);
+  Nan__SetPrototypeAsyncableMethod(lcons, "build", build);
+
+  ATTR(lcons, "bandCount", bandCountGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("VRTBuilder").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+VRTBuilder::VRTBuilder() : Nan::ObjectWrap(), desc({0, 0, false, "", false, {}, false, {}, {}}) {
+}
+
+VRTBuilder::~VRTBuilder() {
+}
+
+// Returns false if an exception has been thrown
+static bool StringsFromObj(Local<Object> obj, const char *key, std::vector<std::string> &var, bool &present) {
+  Local<String> sym = Nan::New(key).ToLocalChecked();
+  if (!Nan::HasOwnProperty(obj, sym).FromMaybe(false)) return true;
+  Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();
+  if (val->IsNull() || val->IsUndefined()) return true;
+  StringList list;
+  if (list.parse(val)) return false;
+  var.clear();
+  for (char **item = list.get(); item != nullptr && *item != nullptr; item++) var.push_back(*item);
+  present = true;
+  return true;
+}
+
+// Returns false if an exception has been thrown
+static bool WindowFromObj(Local<Object> obj, const char *key, double *window) {
+  Local<String> sym = Nan::New(key).ToLocalChecked();
+  if (!Nan::HasOwnProperty(obj, sym).FromMaybe(false)) return true;
+  Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();
+  if (val->IsNull() || val->IsUndefined()) return true;
+  std::string error = std::string("Property \"") + key + "\" must be an object with x, y, width and height";
+  if (!val->IsObject()) {
+    Nan::ThrowTypeError(error.c_str());
+    return false;
+  }
+  static const char *const props[] = {"x", "y", "width", "height"};
+  for (int i = 0; i < 4; i++) {
+    Local<Value> v = Nan::Get(val.As<Object>(), Nan::New(props[i]).ToLocalChecked()).ToLocalChecked();
+    if (!v->IsNumber()) {
+      Nan::ThrowTypeError(error.c_str());
+      return false;
+    }
+    window[i] = Nan::To<double>(v).ToChecked();
+  }
+  if (window[0] < 0 || window[1] < 0 || window[2] <= 0 || window[3] <= 0) {
+    Nan::ThrowRangeError((std::string("Invalid ") + key).c_str());
+    return false;
+  }
+  return true;
+}
+
+// Returns GDT_Unknown with an exception if the name is invalid
+static GDALDataType DataTypeFromName(const std::string &name) {
+  GDALDataType type = GDALGetDataTypeByName(name.c_str());
+  if (type == GDT_Unknown) Nan::ThrowError((std::string("Invalid data type ") + name).c_str());
+  return type;
+}
+
+static CPLStringList ToStringList(const std::vector<std::string> &strings) {
+  CPLStringList r;
+  for (const std::string &s : strings) r.AddString(s.c_str());
+  return r;
+}
+
+/**
+ * @typedef {object} VRTBuilderOptions
+ * @property {xyz} [rasterSize] Size of the VRT raster, defaults to the size of the dataset of the first source
+ * @property {SpatialReference} [srs] Spatial reference, defaults to the one of the first source
+ * @property {number[]} [geoTransform] Geotransform, defaults to the one of the first source
+ * @property {Record<string, string>} [metadata] Dataset metadata, defaults to the one of the first source
+ */
+
+/**
+ * Native builder of in-memory VRT datasets.
+ *
+ * Unlike {@link wrapVRT}, it does not produce an XML description that must be
+ * parsed by GDAL and it never calls synchronous getters on the source datasets -
+ * all their properties are retrieved by {@link VRTBuilder.build|build()} after
+ * acquiring their locks.
+ *
+ * Sources are referenced by filename and are opened by GDAL when the VRT is read,
+ * exactly as when opening a `.vrt` file, so they must be bands of datasets
+ * opened from a file.
+ *
+ * @example
+ * const builder = new gdal.VRTBuilder()
+ * const band = builder.addBand({
+ *   pixelFunc: 'inv',
+ *   pixelFuncArgs: { k: 3 },
+ *   dataType: gdal.GDT_Float32
+ * })
+ * builder.addSimpleSource(band, gdal.open('test/data/sample.tif').bands.get(1))
+ * const ds = await builder.buildAsync()
+ *
+ * @constructor
+ * @class VRTBuilder
+ * @param {VRTBuilderOptions} [options]
+ */
+NAN_METHOD(VRTBuilder::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  Description desc = {0, 0, false, "", false, {}, false, {}, {}};
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+
+  if (!options.IsEmpty()) {
+    Local<String> sym = Nan::New("rasterSize").ToLocalChecked();
+    if (Nan::HasOwnProperty(options, sym).FromMaybe(false)) {
+      Local<Value> val = Nan::Get(options, sym).ToLocalChecked();
+      if (!val->IsObject()) {
+        Nan::ThrowTypeError("rasterSize must be an object");
+        return;
+      }
+      Local<Object> size = val.As<Object>();
+      NODE_INT_FROM_OBJ(size, "x", desc.x_size);
+      NODE_INT_FROM_OBJ(size, "y", desc.y_size);
+      if (desc.x_size <= 0 || desc.y_size <= 0) {
+        Nan::ThrowRangeError("Invalid rasterSize");
+        return;
+      }
+    }
+
+    SpatialReference *srs = nullptr;
+    NODE_WRAPPED_FROM_OBJ_OPT(options, "srs", SpatialReference, srs);
+    if (srs != nullptr) {
+      char *wkt = nullptr;
+      OGRErr err = srs->get()->exportToWkt(&wkt);
+      if (err) {
+        CPLFree(wkt);
+        NODE_THROW_OGRERR(err);
+        return;
+      }
+      desc.has_srs = true;
+      desc.srs_wkt = wkt;
+      CPLFree(wkt);
+    }
+
+    Local<Array> geotransform;
+    NODE_ARRAY_FROM_OBJ_OPT(options, "geoTransform", geotransform);
+    if (!geotransform.IsEmpty()) {
+      if (geotransform->Length() != 6) {
+        Nan::ThrowError("Transform array must have 6 elements");
+        return;
+      }
+      for (unsigned i = 0; i < 6; i++) {
+        Local<Value> val = Nan::Get(geotransform, i).ToLocalChecked();
+        if (!val->IsNumber()) {
+          Nan::ThrowError("Transform array must only contain numbers");
+          return;
+        }
+        desc.geotransform[i] = Nan::To<double>(val).ToChecked();
+      }
+      desc.has_geotransform = true;
+    }
+
+    if (!StringsFromObj(options, "metadata", desc.metadata, desc.has_metadata)) return;
+  }
+
+  VRTBuilder *f = new VRTBuilder();
+  f->desc = desc;
+  f->Wrap(info.This());
+  // The source bands (and their datasets) are kept alive as long as the builder
+  Nan::SetPrivate(info.This(), Nan::New("sources_").ToLocalChecked(), Nan::New<Array>());
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(VRTBuilder::toString) {
+  info.GetReturnValue().Set(Nan::New("VRTBuilder").ToLocalChecked());
+}
+
+/**
+ * @typedef {object} VRTBuilderBandOptions
+ * @property {string} [dataType] Data type of the band, defaults to the data type of its first source
+ * @property {string} [description] Band description, defaults to the description of its first source
+ * @property {number} [noDataValue] No data value of the band
+ * @property {Record<string, string>} [metadata] Band metadata, defaults to the metadata of its first source
+ * @property {string} [pixelFunc] Pixel function to be applied when reading data,
+ * must be a GDAL builtin function or a registered user function
+ * @property {Record<string, string|number>} [pixelFuncArgs] Additional arguments for the pixel function
+ * @property {string} [sourceTransferType] Data type to be used as input of the pixel function
+ * when reading from the sources
+ */
+
+/**
+ * Adds a new band, a band with a pixel function is a derived band.
+ *
+ * @throws {Error}
+ * @method addBand
+ * @instance
+ * @memberof VRTBuilder
+ * @param {VRTBuilderBandOptions} [options]
+ * @return {number} The id of the new band
+ */
+NAN_METHOD(VRTBuilder::addBand) {
+  VRTBuilder *builder = Nan::ObjectWrap::Unwrap<VRTBuilder>(info.This());
+  Local<Object> options;
+  Band band = {GDT_Unknown, false, "", false, 0, "", {}, GDT_Unknown, false, {}, {}};
+
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+
+  if (!options.IsEmpty()) {
+    std::string type_name, transfer_type_name;
+    bool has_args = false;
+
+    NODE_STR_FROM_OBJ_OPT(options, "dataType", type_name);
+    if (!type_name.empty() && (band.type = DataTypeFromName(type_name)) == GDT_Unknown) return;
+
+    if (Nan::HasOwnProperty(options, Nan::New("description").ToLocalChecked()).FromMaybe(false)) {
+      NODE_STR_FROM_OBJ(options, "description", band.description);
+      band.has_description = true;
+    }
+    if (Nan::HasOwnProperty(options, Nan::New("noDataValue").ToLocalChecked()).FromMaybe(false)) {
+      NODE_DOUBLE_FROM_OBJ(options, "noDataValue", band.nodata);
+      band.has_nodata = true;
+    }
+    if (!StringsFromObj(options, "metadata", band.metadata, band.has_metadata)) return;
+
+    NODE_STR_FROM_OBJ_OPT(options, "pixelFunc", band.pixel_func);
+    if (!StringsFromObj(options, "pixelFuncArgs", band.pixel_func_args, has_args)) return;
+    NODE_STR_FROM_OBJ_OPT(options, "sourceTransferType", transfer_type_name);
+    if (!transfer_type_name.empty() &&
+        (band.source_transfer_type = DataTypeFromName(transfer_type_name)) == GDT_Unknown)
+      return;
+
+    if (band.pixel_func.empty() && (has_args || band.source_transfer_type != GDT_Unknown)) {
+      Nan::ThrowError("pixelFuncArgs and sourceTransferType require a pixelFunc");
+      return;
+    }
+  }
+
+  builder->desc.bands.push_back(band);
+  info.GetReturnValue().Set(Nan::New<Integer>(static_cast<int>(builder->desc.bands.size())));
+}
+
+void VRTBuilder::addSource(const Nan::FunctionCallbackInfo<v8::Value> &info, bool complex) {
+  VRTBuilder *builder = Nan::ObjectWrap::Unwrap<VRTBuilder>(info.This());
+  int band_id;
+  RasterBand *source;
+  Local<Object> options;
+
+  NODE_ARG_INT(0, "band", band_id);
+  NODE_ARG_WRAPPED(1, "source", RasterBand, source);
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+
+  if (band_id < 1 || band_id > static_cast<int>(builder->desc.bands.size())) {
+    Nan::ThrowRangeError("Invalid band id");
+    return;
+  }
+
+  Source src = {
+    source->parent_uid,
+    source->uid,
+    source->get(),
+    complex,
+    {-1, -1, -1, -1},
+    {-1, -1, -1, -1},
+    "",
+    VRT_NODATA_UNSET,
+    0,
+    1};
+
+  if (!options.IsEmpty()) {
+    if (!WindowFromObj(options, "srcWindow", src.src)) return;
+    if (!WindowFromObj(options, "dstWindow", src.dst)) return;
+    if (complex) {
+      NODE_DOUBLE_FROM_OBJ_OPT(options, "nodata", src.nodata);
+      NODE_DOUBLE_FROM_OBJ_OPT(options, "scaleOffset", src.scale_offset);
+      NODE_DOUBLE_FROM_OBJ_OPT(options, "scaleRatio", src.scale_ratio);
+    } else {
+      NODE_STR_FROM_OBJ_OPT(options, "resampling", src.resampling);
+    }
+  }
+
+  builder->desc.bands[band_id - 1].sources.push_back(src);
+
+  Local<Array> sources =
+    Nan::GetPrivate(info.This(), Nan::New("sources_").ToLocalChecked()).ToLocalChecked().As<Array>();
+  Nan::Set(sources, sources->Length(), info[1]);
+}
+
+/**
+ * @typedef {object} VRTWindow
+ * @property {number} x
+ * @property {number} y
+ * @property {number} width
+ * @property {number} height
+ */
+
+/**
+ * @typedef {object} VRTSimpleSourceOptions
+ * @property {VRTWindow} [srcWindow] Window to read from the source band, defaults to the whole band
+ * @property {VRTWindow} [dstWindow] Window to write to in the VRT band, defaults to the whole raster
+ * @property {string} [resampling] Resampling algorithm, `near` (default) or `average`
+ */
+
+/**
+ * Adds a simple source to a band, the pixels are copied without any transformation.
+ *
+ * @throws {Error}
+ * @method addSimpleSource
+ * @instance
+ * @memberof VRTBuilder
+ * @param {number} band The id of the band
+ * @param {RasterBand} source Source band, must be a band of a dataset opened from a file
+ * @param {VRTSimpleSourceOptions} [options]
+ * @return {void}
+ */
+NAN_METHOD(VRTBuilder::addSimpleSource) {
+  addSource(info, false);
+}
+
+/**
+ * @typedef {object} VRTComplexSourceOptions
+ * @property {VRTWindow} [srcWindow] Window to read from the source band, defaults to the whole band
+ * @property {VRTWindow} [dstWindow] Window to write to in the VRT band, defaults to the whole raster
+ * @property {number} [nodata] Pixels of the source with this value are transparent
+ * @property {number} [scaleOffset] Offset of the linear scaling applied to the source pixels
+ * @property {number} [scaleRatio] Ratio of the linear scaling applied to the source pixels
+ */
+
+/**
+ * Adds a complex source to a band, supporting nodata and linear scaling.
+ *
+ * @throws {Error}
+ * @method addComplexSource
+ * @instance
+ * @memberof VRTBuilder
+ * @param {number} band The id of the band
+ * @param {RasterBand} source Source band, must be a band of a dataset opened from a file
+ * @param {VRTComplexSourceOptions} [options]
+ * @return {void}
+ */
+NAN_METHOD(VRTBuilder::addComplexSource) {
+  addSource(info, true);
+}
+
+/**
+ * Number of bands added so far.
+ *
+ * @readonly
+ * @kind member
+ * @name bandCount
+ * @instance
+ * @memberof VRTBuilder
+ * @type {number}
+ */
+NAN_GETTER(VRTBuilder::bandCountGetter) {
+  VRTBuilder *builder = Nan::ObjectWrap::Unwrap<VRTBuilder>(info.This());
+  info.GetReturnValue().Set(Nan::New<Integer>(static_cast<int>(builder->desc.bands.size())));
+}
+
+// VRTDerivedRasterBand has no setter for the pixel function arguments, they can
+// only be loaded by XMLInit() from a CPLXMLNode tree which is constructed in memory
+// The signature of XMLInit() differs between GDAL versions and it is deduced here
+template <typename NODE, typename MAP>
+static CPLErr
+XMLInitDerivedBand(VRTDerivedRasterBand *band, CPLErr (VRTDerivedRasterBand::*init)(NODE *, const char *, MAP &),
+                   CPLXMLNode *tree) {
+  MAP shared;
+  return (band->*init)(tree, nullptr, shared);
+}
+
+static CPLErr SetPixelFunction(VRTDerivedRasterBand *band, const VRTBuilder::Band &desc) {
+  CPLXMLNode *tree = CPLCreateXMLNode(nullptr, CXT_Element, "VRTRasterBand");
+  CPLAddXMLAttributeAndValue(tree, "subClass", "VRTDerivedRasterBand");
+  CPLCreateXMLElementAndValue(tree, "PixelFunctionType", desc.pixel_func.c_str());
+  if (desc.source_transfer_type != GDT_Unknown)
+    CPLCreateXMLElementAndValue(tree, "SourceTransferType", GDALGetDataTypeName(desc.source_transfer_type));
+  CPLXMLNode *args = CPLCreateXMLNode(tree, CXT_Element, "PixelFunctionArguments");
+  for (const std::string &arg : desc.pixel_func_args) {
+    char *key = nullptr;
+    const char *value = CPLParseNameValue(arg.c_str(), &key);
+    if (key != nullptr && value != nullptr) CPLAddXMLAttributeAndValue(args, key, value);
+    CPLFree(key);
+  }
+  CPLErr err = XMLInitDerivedBand(band, &VRTDerivedRasterBand::XMLInit, tree);
+  CPLDestroyXMLNode(tree);
+  return err;
+}
+
+// Runs in the worker thread with the locks of all the source datasets
+GDALDataset *VRTBuilder::create(const Description &desc) {
+  // The missing properties of the dataset are copied from the first source
+  const Source *first = nullptr;
+  for (const Band &band : desc.bands)
+    if (!band.sources.empty()) {
+      first = &band.sources.front();
+      break;
+    }
+  GDALDataset *first_ds = first != nullptr ? first->band->GetDataset() : nullptr;
+
+  int x_size = desc.x_size, y_size = desc.y_size;
+  if (x_size == 0 || y_size == 0) {
+    if (first_ds == nullptr) throw "rasterSize must be specified when there are no sources";
+    x_size = first_ds->GetRasterXSize();
+    y_size = first_ds->GetRasterYSize();
+  }
+
+  std::unique_ptr<VRTDataset> vrt(static_cast<VRTDataset *>(GDALDataset::FromHandle(VRTCreate(x_size, y_size))));
+  if (vrt == nullptr) throw CPLGetLastErrorMsg();
+
+  if (desc.has_srs) {
+    OGRSpatialReference srs;
+    if (srs.importFromWkt(desc.srs_wkt.c_str()) != OGRERR_NONE) throw "Invalid SRS";
+    vrt->SetSpatialRef(&srs);
+  } else if (first_ds != nullptr && first_ds->GetSpatialRef() != nullptr) {
+    vrt->SetSpatialRef(first_ds->GetSpatialRef());
+  }
+
+  double geotransform[6];
+  if (desc.has_geotransform) {
+    std::copy(desc.geotransform, desc.geotransform + 6, geotransform);
+    vrt->SetGeoTransform(geotransform);
+  } else if (first_ds != nullptr && first_ds->GetGeoTransform(geotransform) == CE_None) {
+    vrt->SetGeoTransform(geotransform);
+  }
+
+  if (desc.has_metadata) {
+    vrt->SetMetadata(ToStringList(desc.metadata).List());
+  } else if (first_ds != nullptr) {
+    vrt->SetMetadata(first_ds->GetMetadata());
+  }
+
+  int id = 0;
+  for (const Band &desc_band : desc.bands) {
+    id++;
+    GDALRasterBand *first_band = desc_band.sources.empty() ? nullptr : desc_band.sources.front().band;
+
+    GDALDataType type = desc_band.type;
+    if (type == GDT_Unknown) {
+      if (first_band == nullptr) throw "Bands without sources must specify a dataType";
+      type = first_band->GetRasterDataType();
+    }
+
+    CPLStringList options;
+    if (!desc_band.pixel_func.empty()) {
+      options.SetNameValue("subclass", "VRTDerivedRasterBand");
+      options.SetNameValue("PixelFunctionType", desc_band.pixel_func.c_str());
+      if (desc_band.source_transfer_type != GDT_Unknown)
+        options.SetNameValue("SourceTransferType", GDALGetDataTypeName(desc_band.source_transfer_type));
+    }
+    if (vrt->AddBand(type, options.List()) != CE_None) throw CPLGetLastErrorMsg();
+    VRTSourcedRasterBand *band = static_cast<VRTSourcedRasterBand *>(vrt->GetRasterBand(id));
+
+    if (!desc_band.pixel_func_args.empty() &&
+        SetPixelFunction(static_cast<VRTDerivedRasterBand *>(band), desc_band) != CE_None)
+      throw CPLGetLastErrorMsg();
+
+    if (desc_band.has_description) {
+      band->SetDescription(desc_band.description.c_str());
+    } else if (first_band != nullptr) {
+      band->SetDescription(first_band->GetDescription());
+    }
+
+    if (desc_band.has_metadata) {
+      band->SetMetadata(ToStringList(desc_band.metadata).List());
+    } else if (first_band != nullptr) {
+      band->SetMetadata(first_band->GetMetadata());
+    }
+
+    if (desc_band.has_nodata) band->SetNoDataValue(desc_band.nodata);
+
+    for (const Source &source : desc_band.sources) {
+      GDALRasterBand *src = source.band;
+      GDALDataset *src_ds = src->GetDataset();
+      // Overviews and mask bands cannot be referenced by filename
+      if (src_ds == nullptr || src->GetBand() < 1 || src_ds->GetRasterBand(src->GetBand()) != src)
+        throw "Sources must be bands of a Dataset";
+      const char *filename = src_ds->GetDescription();
+      GDALDriver *driver = src_ds->GetDriver();
+      if (filename == nullptr || *filename == '\0' || (driver != nullptr && EQUAL(driver->GetDescription(), "MEM")))
+        throw "Sources must be bands of a Dataset opened from a file";
+
+      double s[4] = {source.src[0], source.src[1], source.src[2], source.src[3]};
+      if (s[2] < 0) {
+        s[0] = s[1] = 0;
+        s[2] = src->GetXSize();
+        s[3] = src->GetYSize();
+      }
+      double d[4] = {source.dst[0], source.dst[1], source.dst[2], source.dst[3]};
+      if (d[2] < 0) {
+        d[0] = d[1] = 0;
+        d[2] = x_size;
+        d[3] = y_size;
+      }
+
+      // The sources are opened on demand when reading, as when opening a VRT file
+      CPLErr err = source.complex
+        ? band->AddComplexSource(
+            filename,
+            src->GetBand(),
+            s[0],
+            s[1],
+            s[2],
+            s[3],
+            d[0],
+            d[1],
+            d[2],
+            d[3],
+            source.scale_offset,
+            source.scale_ratio,
+            source.nodata)
+        : band->AddSimpleSource(
+            filename,
+            src->GetBand(),
+            s[0],
+            s[1],
+            s[2],
+            s[3],
+            d[0],
+            d[1],
+            d[2],
+            d[3],
+            source.resampling.empty() ? "near" : source.resampling.c_str());
+      if (err != CE_None) throw CPLGetLastErrorMsg();
+    }
+  }
+
+  return vrt.release();
+}
+
+/**
+ * Creates the VRT dataset.
+ *
+ * The builder can be reused and modified after this call.
+ *
+ * @throws {Error}
+ * @method build
+ * @instance
+ * @memberof VRTBuilder
+ * @return {Dataset}
+ */
+
+/**
+ * Creates the VRT dataset.
+ * @async
+ *
+ * The builder can be reused and modified after this call.
+ *
+ * @throws {Error}
+ * @method buildAsync
+ * @instance
+ * @memberof VRTBuilder
+ * @param {callback<Dataset>} [callback=undefined]
+ * @return {Promise<Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(VRTBuilder::build) {
+  VRTBuilder *builder = Nan::ObjectWrap::Unwrap<VRTBuilder>(info.This());
+
+  std::vector<long> uids;
+  for (const Band &band : builder->desc.bands)
+    for (const Source &source : band.sources) {
+      if (!object_store.isAlive(source.band_uid)) {
+        THROW_OR_REJECT("Source RasterBand object has already been destroyed");
+        return;
+      }
+      uids.push_back(source.ds_uid);
+    }
+
+  // A snapshot of the description, the builder remains usable
+  auto desc = std::make_shared<Description>(builder->desc);
+
+  // Without sources there is nothing to lock, same as job(0)
+  if (uids.empty()) uids.push_back(0);
+  GDALAsyncableJob<GDALDataset *> job(uids);
+  job.main = [desc](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    return create(*desc);
+  };
+  job.rval = [](GDALDataset *ds, const GetFromPersistentFunc &) { return Dataset::New(ds); };
+  job.run(info, async, 0);
+}
+
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef __NODE_GDAL_VRT_BUILDER_H__
+#define __NODE_GDAL_VRT_BUILDER_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "async.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 5)
+
+// Describes a VRT dataset on the main thread,
+// the VRTDataset is created by build() in a single operation
+class VRTBuilder : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static NAN_METHOD(toString);
+  static NAN_METHOD(addBand);
+  static NAN_METHOD(addSimpleSource);
+  static NAN_METHOD(addComplexSource);
+  GDAL_ASYNCABLE_DECLARE(build);
+
+  static NAN_GETTER(bandCountGetter);
+
+  // The raw pointers are resolved in the worker thread
+  // while holding the locks of their datasets
+  struct Source {
+    long ds_uid;
+    long band_uid;
+    GDALRasterBand *band;
+    bool complex;
+    // -1 = full source band / full VRT raster
+    double src[4];
+    double dst[4];
+    std::string resampling;
+    double nodata;
+    double scale_offset;
+    double scale_ratio;
+  };
+
+  struct Band {
+    GDALDataType type;
+    bool has_description;
+    std::string description;
+    bool has_nodata;
+    double nodata;
+    std::string pixel_func;
+    std::vector<std::string> pixel_func_args;
+    GDALDataType source_transfer_type;
+    bool has_metadata;
+    std::vector<std::string> metadata;
+    std::vector<Source> sources;
+  };
+
+  struct Description {
+    int x_size, y_size;
+    bool has_srs;
+    std::string srs_wkt;
+    bool has_geotransform;
+    double geotransform[6];
+    bool has_metadata;
+    std::vector<std::string> metadata;
+    std::vector<Band> bands;
+  };
+
+  static GDALDataset *create(const Description &desc);
+
+    private:
+  VRTBuilder();
+  ~VRTBuilder();
+  static void addSource(const Nan::FunctionCallbackInfo<v8::Value> &info, bool complex);
+  Description desc;
+};
+
+#endif
+
+} // namespace node_gdal
+#endif
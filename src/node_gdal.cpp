@@ -43,8 +43,14 @@
 #include "gdal_spatial_reference.hpp"
 #include "gdal_memfile.hpp"
 #include "gdal_fs.hpp"
+#include "gdal_cache.hpp"
+#include "gdal_vrt_builder.hpp"
+#include "gdal_mosaic.hpp"
+#include "gdal_raster_index.hpp"
+#include "utils/io_stats.hpp"
 
 #include "utils/field_types.hpp"
+#include "utils/micro_bench.hpp"
 
 // collections
 #include "collections/dataset_bands.hpp"
@@ -78,7 +84,6 @@ namespace node_gdal {
 using namespace node;
 using namespace v8;
 
-FILE *log_file = NULL;
 ObjectStore object_store;
 bool eventLoopWarn = true;
 
@@ -119,6 +124,18 @@ static NAN_SETTER(EventLoopWarningSetter) {
   eventLoopWarn = Nan::To<bool>(value).ToChecked();
 }
 
+static NAN_GETTER(AsyncInlineThresholdGetter) {
+  info.GetReturnValue().Set(Nan::New<Number>(asyncInlineThreshold));
+}
+
+static NAN_SETTER(AsyncInlineThresholdSetter) {
+  if (!value->IsUint32()) {
+    Nan::ThrowError("'asyncInlineThreshold' must be a positive integer");
+    return;
+  }
+  asyncInlineThreshold = Nan::To<uint32_t>(value).ToChecked();
+}
+
 extern "C" {
 
 static NAN_METHOD(QuietOutput) {
@@ -145,14 +162,19 @@ static NAN_METHOD(StartLogging) {
 
 #ifdef ENABLE_LOGGING
   std::string filename = "";
+  std::string level_name = "debug";
   NODE_ARG_STR(0, "filename", filename);
+  NODE_ARG_OPT_STR(1, "level", level_name);
   if (filename.empty()) {
     Nan::ThrowError("Invalid filename");
     return;
   }
-  if (log_file) fclose(log_file);
-  log_file = fopen(filename.c_str(), "w");
-  if (!log_file) {
+  LogLevel level;
+  if (!parseLogLevel(level_name, level)) {
+    Nan::ThrowError("Invalid log level");
+    return;
+  }
+  if (!logger.start(filename, level)) {
     Nan::ThrowError("Error creating log file");
     return;
   }
@@ -169,10 +191,9 @@ static NAN_METHOD(StartLogging) {
 
 static NAN_METHOD(StopLogging) {
 #ifdef ENABLE_LOGGING
-  if (log_file) {
-    fclose(log_file);
-    log_file = NULL;
-  }
+  Nan::RemoveGCPrologueCallback(beforeGC);
+  Nan::RemoveGCEpilogueCallback(afterGC);
+  logger.stop();
 #endif
 
   return;
@@ -180,14 +201,17 @@ static NAN_METHOD(StopLogging) {
 
 static NAN_METHOD(Log) {
   std::string msg;
+  std::string level_name = "info";
   NODE_ARG_STR(0, "message", msg);
-  msg = msg + "\n";
+  NODE_ARG_OPT_STR(1, "level", level_name);
 
 #ifdef ENABLE_LOGGING
-  if (log_file) {
-    fputs(msg.c_str(), log_file);
-    fflush(log_file);
+  LogLevel level;
+  if (!parseLogLevel(level_name, level)) {
+    Nan::ThrowError("Invalid log level");
+    return;
   }
+  if (logger.enabled(level)) logger.log(level, "%s", msg.c_str());
 #endif
 
   return;
@@ -206,6 +230,7 @@ GDAL_ASYNCABLE_DEFINE(gdal_open) {
   NODE_ARG_OPT_STR(1, "mode", mode);
 
   unsigned int flags = 0;
+  bool io_stats = false;
   for (unsigned i = 0; i < mode.length(); i++) {
     if (mode[i] == 'r') {
       if (i < mode.length() - 1 && mode[i + 1] == '+') {
@@ -219,6 +244,13 @@ GDAL_ASYNCABLE_DEFINE(gdal_open) {
       flags |= GDAL_OF_MULTIDIM_RASTER;
 #else
       Nan::ThrowError("Multidimensional support requires GDAL 3.1");
+#endif
+    } else if (mode[i] == 's') {
+#if GDAL_VERSION_MAJOR >= 3
+      io_stats = true;
+#else
+      Nan::ThrowError("I/O statistics require GDAL 3.0");
+      return;
 #endif
     } else if (mode[i] == 't') {
 #if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 10)
@@ -228,17 +260,26 @@ GDAL_ASYNCABLE_DEFINE(gdal_open) {
       return;
 #endif
     } else {
-      Nan::ThrowError("Invalid open mode. Must contain only \"r\" or \"r+\" and \"m\" or \"t\" ");
+      Nan::ThrowError("Invalid open mode. Must contain only \"r\" or \"r+\" and \"m\", \"t\" or \"s\" ");
       return;
     }
   }
   flags |= GDAL_OF_VERBOSE_ERROR;
 
+  std::shared_ptr<IOStats> stats;
+  if (io_stats) stats = IOStats::create(path, path);
+
+  // The snapshot is taken by the worker, it may need I/O
+  auto snapshot = std::make_shared<Dataset::Snapshot>();
   GDALAsyncableJob<GDALDataset *> job(0);
-  job.rval = [](GDALDataset *ds, const GetFromPersistentFunc &) { return Dataset::New(ds); };
-  job.main = [path, flags](const GDALExecutionProgress &) {
+  job.rval = [snapshot](GDALDataset *ds, const GetFromPersistentFunc &) {
+    return Dataset::New(ds, nullptr, snapshot.get());
+  };
+  job.main = [path, flags, stats, snapshot](const GDALExecutionProgress &) {
     GDALDataset *ds = (GDALDataset *)GDALOpenEx(path.c_str(), flags, NULL, NULL, NULL);
     if (!ds) throw CPLGetLastErrorMsg();
+    if (stats) IOStats::attach(ds, stats);
+    Dataset::takeSnapshot(ds, *snapshot);
     return ds;
   };
   job.run(info, async, 2);
@@ -351,6 +392,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   }
   initialized = true;
   mainV8ThreadId = std::this_thread::get_id();
+  Trace::Initialize();
 
   Nan__SetAsyncableMethod(target, "open", gdal_open);
   Nan::SetMethod(target, "setConfigOption", setConfigOption);
@@ -359,6 +401,9 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Nan::SetMethod(target, "setPROJSearchPath", setPROJSearchPath);
   Nan::SetMethod(target, "_triggerCPLError", ThrowDummyCPLError); // for tests
   Nan::SetMethod(target, "_isAlive", isAlive);                    // for tests
+#ifdef ENABLE_MICRO_BENCH
+  Nan::SetMethod(target, "_microBench", microBench); // bench/native.js
+#endif
 
   Warper::Initialize(target);
   Algorithms::Initialize(target);
@@ -418,6 +463,13 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Memfile::Initialize(target);
   Utils::Initialize(target);
   VSI::Initialize(target);
+  BlockCache::Initialize(target);
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 5)
+  VRTBuilder::Initialize(target);
+#endif
+  Mosaic::Initialize(target);
+  RasterIndex::Initialize(target);
+  IOStats::Initialize();
 
   /**
    * The collection of all drivers registered with GDAL
@@ -1802,6 +1854,29 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Nan::SetAccessor(
     target, Nan::New<v8::String>("eventLoopWarning").ToLocalChecked(), EventLoopWarningGetter, EventLoopWarningSetter);
 
+  /**
+   * Maximum expected duration in microseconds of an asynchronous operation
+   * that can be executed directly on the main thread, 0 (the default) disables this feature
+   *
+   * The expected duration is estimated from the previous executions of the same method,
+   * an operation is executed inline only when it returns a Promise, does not have a
+   * progress callback and its datasets are neither locked nor used by another pending
+   * asynchronous operation - the result is still delivered through the Promise
+   *
+   * The estimation cannot predict an operation that is much slower than the previous ones,
+   * such as a block cache miss after a series of hits or a network file opened after
+   * local files, and such an operation will block the event loop
+   * Use `(gdal as any).asyncInlineThreshold = 20` to set the value from TypeScript
+   *
+   * @var {number} asyncInlineThreshold
+   * @default 0
+   */
+  Nan::SetAccessor(
+    target,
+    Nan::New<v8::String>("asyncInlineThreshold").ToLocalChecked(),
+    AsyncInlineThresholdGetter,
+    AsyncInlineThresholdSetter);
+
   // Local<Object> versions = Nan::New<Object>();
   // Nan::Set(versions, Nan::New("node").ToLocalChecked(),
   // Nan::New(NODE_VERSION+1)); Nan::Set(versions,
@@ -0,0 +1,206 @@
+#include "io_stats.hpp"
+
+#include <cpl_vsi.h>
+#include <cpl_vsi_virtual.h>
+#include <stdlib.h>
+
+namespace node_gdal {
+
+static const char prefix[] = "/vsiiostats/";
+
+std::mutex IOStats::lock;
+std::map<long, std::weak_ptr<IOStats>> IOStats::ids;
+std::map<GDALDataset *, std::shared_ptr<IOStats>> IOStats::datasets;
+std::atomic<int> IOStats::attached(0);
+long IOStats::next_id = 1;
+
+IOStats::IOStats()
+  : bytes_read(0), reads(0), seeks(0), bytes_written(0), writes(0), block_decodes(0), cache_hits(0) {
+}
+
+void IOStats::reset() {
+  bytes_read = 0;
+  reads = 0;
+  seeks = 0;
+  bytes_written = 0;
+  writes = 0;
+  block_decodes = 0;
+  cache_hits = 0;
+}
+
+std::shared_ptr<IOStats> IOStats::create(const std::string &path, std::string &wrapped) {
+  auto stats = std::make_shared<IOStats>();
+  std::lock_guard<std::mutex> guard(lock);
+  // Forget the counters that are not used anymore
+  for (auto it = ids.begin(); it != ids.end();) {
+    if (it->second.expired())
+      it = ids.erase(it);
+    else
+      it++;
+  }
+  long id = next_id++;
+  ids[id] = stats;
+  wrapped = prefix + std::to_string(id) + "/" + path;
+  return stats;
+}
+
+std::shared_ptr<IOStats> IOStats::get(long id) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = ids.find(id);
+  if (it == ids.end()) return nullptr;
+  return it->second.lock();
+}
+
+void IOStats::attach(GDALDataset *ds, const std::shared_ptr<IOStats> &stats) {
+  std::lock_guard<std::mutex> guard(lock);
+  datasets[ds] = stats;
+  attached = static_cast<int>(datasets.size());
+}
+
+void IOStats::detach(GDALDataset *ds) {
+  if (attached == 0) return;
+  std::lock_guard<std::mutex> guard(lock);
+  datasets.erase(ds);
+  attached = static_cast<int>(datasets.size());
+}
+
+std::shared_ptr<IOStats> IOStats::get(GDALDataset *ds) {
+  if (attached == 0) return nullptr;
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = datasets.find(ds);
+  if (it == datasets.end()) return nullptr;
+  return it->second;
+}
+
+// The /vsiiostats/ filesystem
+// /vsiiostats/<id>/<path> forwards to <path> and counts in the IOStats <id>
+// The VSI plugin API requires GDAL 3.0, the "s" open mode is not available before
+#if GDAL_VERSION_MAJOR >= 3
+
+struct IOStatsHandle {
+  VSILFILE *file;
+  std::shared_ptr<IOStats> stats;
+};
+
+// Returns the real path and the counters of a /vsiiostats/ path
+static const char *unwrap(const char *filename, std::shared_ptr<IOStats> *stats) {
+  const char *p = filename + sizeof(prefix) - 1;
+  char *end;
+  long id = strtol(p, &end, 10);
+  if (end == p || *end != '/') return nullptr;
+  if (stats != nullptr) {
+    *stats = IOStats::get(id);
+    if (*stats == nullptr) return nullptr;
+  }
+  return end + 1;
+}
+
+static void *vsiOpen(void *, const char *filename, const char *access) {
+  std::shared_ptr<IOStats> stats;
+  const char *path = unwrap(filename, &stats);
+  if (path == nullptr) return nullptr;
+  VSILFILE *file = VSIFOpenExL(path, access, TRUE);
+  if (file == nullptr) return nullptr;
+  return new IOStatsHandle{file, stats};
+}
+
+static int vsiStat(void *, const char *filename, VSIStatBufL *buf, int flags) {
+  const char *path = unwrap(filename, nullptr);
+  if (path == nullptr) return -1;
+  return VSIStatExL(path, buf, flags);
+}
+
+static char **vsiReadDir(void *, const char *dirname, int max) {
+  const char *path = unwrap(dirname, nullptr);
+  if (path == nullptr) return nullptr;
+  return VSIReadDirEx(path, max);
+}
+
+static vsi_l_offset vsiTell(void *handle) {
+  return VSIFTellL(static_cast<IOStatsHandle *>(handle)->file);
+}
+
+static int vsiSeek(void *handle, vsi_l_offset offset, int whence) {
+  IOStatsHandle *h = static_cast<IOStatsHandle *>(handle);
+  // Only the seeks that move the file pointer are counted
+  if (whence != SEEK_SET || offset != VSIFTellL(h->file)) h->stats->seeks++;
+  return VSIFSeekL(h->file, offset, whence);
+}
+
+static size_t vsiRead(void *handle, void *buffer, size_t size, size_t count) {
+  IOStatsHandle *h = static_cast<IOStatsHandle *>(handle);
+  size_t r = VSIFReadL(buffer, size, count, h->file);
+  h->stats->reads++;
+  h->stats->bytes_read += r * size;
+  return r;
+}
+
+static size_t vsiWrite(void *handle, const void *buffer, size_t size, size_t count) {
+  IOStatsHandle *h = static_cast<IOStatsHandle *>(handle);
+  size_t r = VSIFWriteL(buffer, size, count, h->file);
+  h->stats->writes++;
+  h->stats->bytes_written += r * size;
+  return r;
+}
+
+// A multi-range read (COG tiles on /vsicurl/) is counted as a single read
+static int vsiReadMultiRange(void *handle, int n, void **buffers, const vsi_l_offset *offsets, const size_t *sizes) {
+  IOStatsHandle *h = static_cast<IOStatsHandle *>(handle);
+  int r = VSIFReadMultiRangeL(n, buffers, offsets, sizes, h->file);
+  h->stats->reads++;
+  if (r == 0)
+    for (int i = 0; i < n; i++) h->stats->bytes_read += sizes[i];
+  return r;
+}
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+static void vsiAdviseRead(void *handle, int n, const vsi_l_offset *offsets, const size_t *sizes) {
+  reinterpret_cast<VSIVirtualHandle *>(static_cast<IOStatsHandle *>(handle)->file)->AdviseRead(n, offsets, sizes);
+}
+#endif
+
+static int vsiEof(void *handle) {
+  return VSIFEofL(static_cast<IOStatsHandle *>(handle)->file);
+}
+
+static int vsiFlush(void *handle) {
+  return VSIFFlushL(static_cast<IOStatsHandle *>(handle)->file);
+}
+
+static int vsiTruncate(void *handle, vsi_l_offset size) {
+  return VSIFTruncateL(static_cast<IOStatsHandle *>(handle)->file, size);
+}
+
+static int vsiClose(void *handle) {
+  IOStatsHandle *h = static_cast<IOStatsHandle *>(handle);
+  int r = VSIFCloseL(h->file);
+  delete h;
+  return r;
+}
+
+#endif
+
+void IOStats::Initialize() {
+#if GDAL_VERSION_MAJOR >= 3
+  VSIFilesystemPluginCallbacksStruct *cb = VSIAllocFilesystemPluginCallbacksStruct();
+  cb->open = vsiOpen;
+  cb->stat = vsiStat;
+  cb->read_dir = vsiReadDir;
+  cb->tell = vsiTell;
+  cb->seek = vsiSeek;
+  cb->read = vsiRead;
+  cb->read_multi_range = vsiReadMultiRange;
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+  cb->advise_read = vsiAdviseRead;
+#endif
+  cb->write = vsiWrite;
+  cb->eof = vsiEof;
+  cb->flush = vsiFlush;
+  cb->truncate = vsiTruncate;
+  cb->close = vsiClose;
+  VSIInstallPluginHandler(prefix, cb);
+  VSIFreeFilesystemPluginCallbacksStruct(cb);
+#endif
+}
+
+} // namespace node_gdal
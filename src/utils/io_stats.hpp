@@ -0,0 +1,58 @@
+#ifndef __NODE_GDAL_IO_STATS_H__
+#define __NODE_GDAL_IO_STATS_H__
+
+// gdal
+#include <gdal_priv.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace node_gdal {
+
+// Per-dataset I/O accounting, enabled by opening a dataset with the "s" mode
+//
+// The file is opened through the /vsiiostats/<id>/ filesystem which forwards
+// every operation to the real file and counts them, the side-car files found
+// by the driver (overviews, .aux.xml, world files...) go through it too
+// Multi-range reads and read advices are forwarded to the real file
+// Requires GDAL 3.0
+// The block decodes and the cache hits are counted by BlockCache::Accounting
+class IOStats {
+    public:
+  std::atomic<uint64_t> bytes_read;
+  std::atomic<uint64_t> reads;
+  std::atomic<uint64_t> seeks;
+  std::atomic<uint64_t> bytes_written;
+  std::atomic<uint64_t> writes;
+  std::atomic<uint64_t> block_decodes;
+  std::atomic<uint64_t> cache_hits;
+
+  IOStats();
+  void reset();
+
+  static void Initialize();
+
+  // Create a new set of counters and return the path that must be opened to use them
+  static std::shared_ptr<IOStats> create(const std::string &path, std::string &wrapped);
+  static std::shared_ptr<IOStats> get(long id);
+
+  // Associate the counters with the dataset opened on the wrapped path
+  static void attach(GDALDataset *ds, const std::shared_ptr<IOStats> &stats);
+  static void detach(GDALDataset *ds);
+  static std::shared_ptr<IOStats> get(GDALDataset *ds);
+
+    private:
+  static std::mutex lock;
+  static std::map<long, std::weak_ptr<IOStats>> ids;
+  static std::map<GDALDataset *, std::shared_ptr<IOStats>> datasets;
+  // Avoids taking the lock on the I/O path when the feature is not used
+  static std::atomic<int> attached;
+  static long next_id;
+};
+
+} // namespace node_gdal
+
+#endif
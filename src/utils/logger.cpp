@@ -0,0 +1,139 @@
+#include "logger.hpp"
+
+#include <cpl_port.h>
+#include <functional>
+#include <stdarg.h>
+
+namespace node_gdal {
+
+Logger logger;
+
+static const char *levelNames[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+
+bool parseLogLevel(const std::string &name, LogLevel &level) {
+  for (int i = 0; i < static_cast<int>(LogLevel::Off); i++) {
+    if (EQUAL(name.c_str(), levelNames[i])) {
+      level = static_cast<LogLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Computing the hash of the thread id every time would be wasteful
+static inline size_t threadId() {
+  static thread_local size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  return id;
+}
+
+Logger::Logger()
+  : ring(new Slot[slots]),
+    head(0),
+    tail(0),
+    dropped(0),
+    min_level(static_cast<int>(LogLevel::Off)),
+    epoch(std::chrono::steady_clock::now()),
+    file(nullptr),
+    running(false) {
+  for (size_t i = 0; i < slots; i++) ring[i].seq.store(i, std::memory_order_relaxed);
+}
+
+Logger::~Logger() {
+  stop();
+}
+
+bool Logger::start(const std::string &filename, LogLevel level) {
+  stop();
+  file = fopen(filename.c_str(), "w");
+  if (file == nullptr) return false;
+  epoch = std::chrono::steady_clock::now();
+  running = true;
+  drainer = std::thread(&Logger::drain, this);
+  min_level.store(static_cast<int>(level), std::memory_order_relaxed);
+  return true;
+}
+
+void Logger::stop() {
+  min_level.store(static_cast<int>(LogLevel::Off), std::memory_order_relaxed);
+  if (!running) return;
+  {
+    std::lock_guard<std::mutex> lock(sleep_lock);
+    running = false;
+  }
+  wakeup.notify_one();
+  drainer.join();
+  fclose(file);
+  file = nullptr;
+}
+
+void Logger::log(LogLevel level, const char *fmt, ...) {
+  if (!enabled(level)) return;
+
+  size_t pos = head.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &ring[pos % slots];
+    size_t seq = slot->seq.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      // The consumer is lagging a whole ring behind
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->level = level;
+  slot->time =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+  slot->thread = threadId();
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(slot->msg, msg_size, fmt, args);
+  va_end(args);
+  slot->seq.store(pos + 1, std::memory_order_release);
+
+  // The drainer polls, wake it up early only when the ring is filling up
+  if (pos % (slots / 2) == 0) wakeup.notify_one();
+}
+
+// Write everything that is ready, returns false if there was nothing
+bool Logger::flush() {
+  bool written = false;
+  for (;;) {
+    Slot &slot = ring[tail % slots];
+    if (slot.seq.load(std::memory_order_acquire) != tail + 1) break;
+    fprintf(
+      file,
+      "%lld.%06lld [%zx] %s %s\n",
+      slot.time / 1000000,
+      slot.time % 1000000,
+      slot.thread,
+      levelNames[static_cast<int>(slot.level)],
+      slot.msg);
+    slot.seq.store(tail + slots, std::memory_order_release);
+    tail++;
+    written = true;
+  }
+  size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+  if (lost > 0) {
+    fprintf(file, "%zu messages dropped\n", lost);
+    written = true;
+  }
+  if (written) fflush(file);
+  return written;
+}
+
+void Logger::drain() {
+  while (running) {
+    if (flush()) continue;
+    std::unique_lock<std::mutex> lock(sleep_lock);
+    if (running) wakeup.wait_for(lock, std::chrono::milliseconds(50));
+  }
+  flush();
+}
+
+} // namespace node_gdal
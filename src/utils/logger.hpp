@@ -0,0 +1,78 @@
+#ifndef __NODE_GDAL_LOGGER_H__
+#define __NODE_GDAL_LOGGER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <thread>
+
+namespace node_gdal {
+
+enum class LogLevel : int { Debug = 0, Info = 1, Warning = 2, Error = 3, Off = 4 };
+
+// The logger is meant to be usable in production under load
+//
+// Producers (any thread, including the main thread during GC) format the message
+// directly into a slot of a bounded lock-free ring buffer and never block,
+// when the buffer is full the message is dropped and counted
+// A background thread drains the buffer and is the only one writing to the file
+//
+// The ring buffer is a multiple-producer single-consumer version of
+// Dmitry Vyukov's bounded queue: every slot carries a sequence number that tells
+// if it is free for the producer at that position or ready for the consumer
+class Logger {
+    public:
+  static constexpr size_t slots = 4096;
+  static constexpr size_t msg_size = 240;
+
+  Logger();
+  ~Logger();
+
+  bool start(const std::string &filename, LogLevel level);
+  void stop();
+  inline bool enabled(LogLevel level) {
+    return static_cast<int>(level) >= min_level.load(std::memory_order_relaxed);
+  }
+  void log(LogLevel level, const char *fmt, ...)
+#ifdef __GNUC__
+    __attribute__((format(printf, 3, 4)))
+#endif
+    ;
+
+    private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    LogLevel level;
+    long long time;
+    size_t thread;
+    char msg[msg_size];
+  };
+
+  std::unique_ptr<Slot[]> ring;
+  std::atomic<size_t> head;
+  size_t tail;
+  std::atomic<size_t> dropped;
+  std::atomic<int> min_level;
+  std::chrono::steady_clock::time_point epoch;
+
+  FILE *file;
+  std::thread drainer;
+  std::atomic<bool> running;
+  std::mutex sleep_lock;
+  std::condition_variable wakeup;
+
+  void drain();
+  bool flush();
+};
+
+extern Logger logger;
+
+bool parseLogLevel(const std::string &name, LogLevel &level);
+
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,187 @@
+#ifdef ENABLE_MICRO_BENCH
+
+#include "micro_bench.hpp"
+#include "../async.hpp"
+#include "../gdal_common.hpp"
+#include "../gdal_dataset.hpp"
+#include "../collections/rasterband_pixels.hpp"
+#include "node_gdal.h"
+#include "ptr_manager.hpp"
+#include "typed_array.hpp"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace node_gdal {
+
+// Prevents the compiler from optimizing away the benchmarked code
+static volatile int64_t sink;
+
+// A benchmark body runs <iterations> times the measured operation
+// in the thread <thread> of <threads>
+typedef std::function<void(long, int64_t, int)> BenchFunc;
+
+struct BenchCase {
+  bool needs_dataset;
+  // Uses V8 and can only run on the main thread
+  bool main_thread_only;
+  BenchFunc run;
+};
+
+static std::map<std::string, BenchCase> benchmarks() {
+  std::map<std::string, BenchCase> r;
+
+  r["lockDataset"] = {true, false, [](long uid, int64_t iterations, int) {
+                        for (int64_t i = 0; i < iterations; i++) {
+                          AsyncLock lock = object_store.lockDataset(uid);
+                          if (lock != nullptr) object_store.unlockDataset(lock);
+                        }
+                      }};
+
+  r["tryLockDatasets"] = {true, false, [](long uid, int64_t iterations, int) {
+                            std::vector<long> uids = {uid};
+                            for (int64_t i = 0; i < iterations; i++) {
+                              bool success;
+                              std::vector<AsyncLock> locks = object_store.tryLockDatasets(uids, success);
+                              if (success) object_store.unlockDatasets(locks);
+                            }
+                          }};
+
+  r["findLowest/findHighest"] = {false, false, [](long, int64_t iterations, int thread) {
+                                   int64_t acc = 0;
+                                   for (int64_t i = 0; i < iterations; i++) {
+                                     int64_t px = (i & 1) ? 4 : -4;
+                                     int64_t ln = (i & 2) ? 4096 : -4096;
+                                     acc += findLowest(1024, 1024 + thread, px, ln, i & 0xff);
+                                     acc += findHighest(1024, 1024 + thread, px, ln, i & 0xff);
+                                   }
+                                   sink = acc;
+                                 }};
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 5)
+  r["ParseCSLConstList"] = {false, false, [](long, int64_t iterations, int) {
+                              const char *const list[] = {
+                                "source_values=1,2,3",
+                                "dialect=Python",
+                                "nodata=0",
+                                "scale=1.0",
+                                "offset=0.0",
+                                "name=band",
+                                "unit=m",
+                                "flag",
+                                nullptr};
+                              for (int64_t i = 0; i < iterations; i++) {
+                                std::map<std::string, std::string> dict;
+                                ParseCSLConstList(list, dict);
+                                sink = dict.size();
+                              }
+                            }};
+#endif
+
+  r["TypedArray::New"] = {false, true, [](long, int64_t iterations, int) {
+                            for (int64_t i = 0; i < iterations; i++) {
+                              Nan::HandleScope scope;
+                              Local<Value> array = TypedArray::New(GDT_Float32, 256);
+                              sink = array.IsEmpty();
+                            }
+                          }};
+
+  r["TypedArray::Validate"] = {false, true, [](long, int64_t iterations, int) {
+                                 Nan::HandleScope scope;
+                                 Local<Object> array = TypedArray::New(GDT_Float32, 256).As<Object>();
+                                 for (int64_t i = 0; i < iterations; i++) {
+                                   sink = reinterpret_cast<int64_t>(TypedArray::Validate(array, GDT_Float32, 256));
+                                 }
+                               }};
+
+  r["GDALAsyncableJob"] = {true, true, [](long uid, int64_t iterations, int) {
+                             Nan::HandleScope scope;
+                             Local<Object> obj = Nan::New<Object>();
+                             for (int64_t i = 0; i < iterations; i++) {
+                               GDALAsyncableJob<int> job(uid);
+                               job.persist(obj);
+                               job.main = [i](const GDALExecutionProgress &) { return static_cast<int>(i); };
+                               job.rval = [](int r, const GetFromPersistentFunc &) { return Nan::New<Number>(r); };
+                               sink = job.progress == nullptr;
+                             }
+                           }};
+
+  return r;
+}
+
+/*
+ * Run a native micro-benchmark
+ *
+ * _microBench(name: string, iterations: number, threads?: number, ds?: Dataset): number
+ *
+ * Returns the average wall clock time per operation in nanoseconds,
+ * with threads > 1 every thread runs <iterations> operations concurrently
+ * and the result is the total time divided by the total number of operations
+ */
+NAN_METHOD(microBench) {
+  std::string name;
+  int64_t iterations;
+  int threads = 1;
+  Dataset *ds = nullptr;
+
+  NODE_ARG_STR(0, "name", name);
+  NODE_ARG_INT(1, "iterations", iterations);
+  NODE_ARG_INT_OPT(2, "threads", threads);
+  NODE_ARG_WRAPPED_OPT(3, "dataset", Dataset, ds);
+
+  if (name.empty()) {
+    // List the available benchmarks
+    Local<Array> list = Nan::New<Array>();
+    int i = 0;
+    for (auto const &b : benchmarks()) Nan::Set(list, i++, SafeString::New(b.first.c_str()));
+    info.GetReturnValue().Set(list);
+    return;
+  }
+
+  auto all = benchmarks();
+  auto bench = all.find(name);
+  if (bench == all.end()) {
+    Nan::ThrowError("Unknown benchmark");
+    return;
+  }
+  if (iterations <= 0 || threads <= 0) {
+    Nan::ThrowRangeError("iterations and threads must be positive");
+    return;
+  }
+  if (bench->second.main_thread_only && threads > 1) {
+    Nan::ThrowError("This benchmark can only run on the main thread");
+    return;
+  }
+  if (bench->second.needs_dataset && ds == nullptr) {
+    Nan::ThrowError("This benchmark requires a Dataset");
+    return;
+  }
+  long uid = ds != nullptr ? ds->uid : 0;
+  const BenchFunc &run = bench->second.run;
+
+  auto start = std::chrono::steady_clock::now();
+  try {
+    if (threads == 1) {
+      run(uid, iterations, 0);
+    } else {
+      std::vector<std::thread> workers;
+      for (int t = 0; t < threads; t++) workers.emplace_back(run, uid, iterations, t);
+      for (auto &w : workers) w.join();
+    }
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+  info.GetReturnValue().Set(
+    Nan::New<Number>(static_cast<double>(elapsed.count()) / (static_cast<double>(iterations) * threads)));
+}
+
+} // namespace node_gdal
+
+#endif
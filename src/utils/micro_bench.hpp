@@ -0,0 +1,22 @@
+#ifndef __NODE_GDAL_MICRO_BENCH_H__
+#define __NODE_GDAL_MICRO_BENCH_H__
+
+#ifdef ENABLE_MICRO_BENCH
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+namespace node_gdal {
+
+// Native micro-benchmarks of the internal primitives that are on the hot path
+// of every (async) call, only built with --enable_micro_bench=true
+// (see bench/native.js)
+NAN_METHOD(microBench);
+
+} // namespace node_gdal
+
+#endif
+#endif
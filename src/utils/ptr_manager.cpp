@@ -6,6 +6,7 @@
 #include "../gdal_attribute.hpp"
 #include "../gdal_layer.hpp"
 #include "../gdal_rasterband.hpp"
+#include "io_stats.hpp"
 
 #include <sstream>
 #include <thread>
@@ -114,6 +115,7 @@ bool ObjectStore::isAlive(long uid) {
 }
 
 static inline void sortUnique(vector<long> &uids) {
+  if (uids.empty()) return;
   // Avoid deadlocks
   sort(uids.begin(), uids.end());
   // Eliminate dupes and 0s
@@ -369,6 +371,7 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<GDALDataset *>>
 
   if (item->ptr) {
     LOG("Closing GDALDataset %ld [%p]", item->uid, item->ptr);
+    IOStats::detach(item->ptr);
     GDALClose(item->ptr);
     item->ptr = nullptr;
   }
@@ -397,6 +400,24 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<OGRLayer *>> it
   }
 }
 
+// Explicit release of an SQL results layer (called with the lock of its parent Dataset held)
+// The Layer object is left in place but it is not alive anymore
+bool ObjectStore::releaseResultSet(long uid) {
+  shared_ptr<ObjectStoreItem<OGRLayer *>> item;
+  {
+    uv_scoped_mutex lock(&master_lock);
+    if (!uidMap<OGRLayer *>.count(uid)) return false;
+    item = uidMap<OGRLayer *>[uid];
+    if (!item->is_result_set || item->parent == nullptr) return false;
+    ptrMap<OGRLayer *>.erase(item->ptr);
+    uidMap<OGRLayer *>.erase(item->uid);
+    item->parent->children.remove(item->uid);
+  }
+  LOG("Releasing OGRLayer with SQL results [%ld] [%p]", uid, item->ptr);
+  item->parent->ptr->ReleaseResultSet(item->ptr);
+  return true;
+}
+
 // Generic disposal (called with the master lock held)
 template <typename GDALPTR> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<GDALPTR>> item, bool) {
   ptrMap<GDALPTR>.erase(item->ptr);
@@ -62,6 +62,7 @@ class ObjectStore {
   long add(GDALDataset *ptr, Nan::Persistent<Object> &obj, long parent_uid);
 
   void dispose(long uid, bool manual = false);
+  bool releaseResultSet(long uid);
   bool isAlive(long uid);
   inline void lockDataset(AsyncLock lock) {
     uv_sem_wait(lock.get());
@@ -0,0 +1,55 @@
+#include "trace.hpp"
+
+#include <node.h>
+#include <string.h>
+
+namespace node_gdal {
+
+const uint8_t *Trace::category = nullptr;
+
+// From V8's trace_event_common.h
+static const char phaseBegin = 'B';
+static const char phaseEnd = 'E';
+static const char phaseInstant = 'I';
+static const uint8_t typeInt = 3;
+static const uint8_t typeDouble = 4;
+
+void Trace::Initialize() {
+  v8::TracingController *controller = node::GetTracingController();
+  if (controller != nullptr) category = controller->GetCategoryGroupEnabled(category_name);
+}
+
+static inline void emit(
+  char phase, const char *name, int num_args, const char **names, const uint8_t *types, const uint64_t *values) {
+  node::GetTracingController()->AddTraceEvent(
+    phase, Trace::category, name, nullptr, 0, 0, num_args, names, types, values, nullptr, 0);
+}
+
+void Trace::Progress(double complete) {
+  if (!enabled()) return;
+  const char *names[] = {"complete"};
+  const uint8_t types[] = {typeDouble};
+  uint64_t values[1];
+  memcpy(&values[0], &complete, sizeof(double));
+  emit(phaseInstant, "progress", 1, names, types, values);
+}
+
+Trace::Scope::Scope(const char *name, long uid, int64_t bytes) : name(name), active(enabled()) {
+  if (!active) return;
+  const char *names[] = {"uid", "bytes"};
+  const uint8_t types[] = {typeInt, typeInt};
+  const uint64_t values[] = {static_cast<uint64_t>(uid), static_cast<uint64_t>(bytes)};
+  emit(phaseBegin, name, bytes >= 0 ? 2 : 1, names, types, values);
+}
+
+Trace::Scope::~Scope() {
+  end();
+}
+
+void Trace::Scope::end() {
+  if (!active) return;
+  active = false;
+  emit(phaseEnd, name, 0, nullptr, nullptr, nullptr);
+}
+
+} // namespace node_gdal
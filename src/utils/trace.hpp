@@ -0,0 +1,45 @@
+#ifndef __NODE_GDAL_TRACE_H__
+#define __NODE_GDAL_TRACE_H__
+
+#include <stdint.h>
+
+namespace node_gdal {
+
+// Trace events of the node-gdal category
+//
+// They go to the Node.js tracing controller and appear in the trace log with the
+// events of Node.js itself when it is started with --trace-event-categories node-gdal
+// The tracing controller is thread-safe, the events can be emitted from any thread
+// and when the category is not enabled, the cost is that of reading a flag
+namespace Trace {
+
+static const char category_name[] = "node-gdal";
+
+extern const uint8_t *category;
+
+void Initialize();
+
+inline bool enabled() {
+  return category != nullptr && *category != 0;
+}
+
+// An instant event carrying the progress of an operation
+void Progress(double complete);
+
+// A begin/end pair of events on the current thread
+class Scope {
+    public:
+  Scope(const char *name, long uid, int64_t bytes = -1);
+  ~Scope();
+  // End the scope before it goes out of scope
+  void end();
+
+    private:
+  const char *name;
+  bool active;
+};
+
+} // namespace Trace
+} // namespace node_gdal
+
+#endif
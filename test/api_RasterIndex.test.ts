@@ -0,0 +1,208 @@
+import * as gdal from 'gdal-async'
+import { assert } from 'chai'
+import * as path from 'path'
+
+describe('gdal.RasterIndex', () => {
+  const sample = path.resolve(__dirname, 'data', 'sample.tif')
+  const multiband = path.resolve(__dirname, 'data', 'multiband.tif')
+
+  // a grid of 10x10 tiles of 1x1 units, tile (x, y) is at x + y * 10
+  const createGrid = () => {
+    const index = new gdal.RasterIndex()
+    for (let y = 0; y < 10; y++) {
+      for (let x = 0; x < 10; x++) {
+        index.add(`tile_${x}_${y}.tif`, { minX: x, minY: y, maxX: x + 1, maxY: y + 1 }, {
+          srs: 'EPSG:3857',
+          resolution: { x: 0.01, y: 0.01 },
+          time: Date.UTC(2020, 0, 1 + x)
+        })
+      }
+    }
+    return index
+  }
+
+  const ids = (entries: gdal.RasterIndexEntry[]) => entries.map((e) => e.id).sort((a, b) => a - b)
+
+  const boundsOf = (file: string) => {
+    const ds = gdal.open(file)
+    const gt = ds.geoTransform as number[]
+    return {
+      minX: gt[0],
+      maxX: gt[0] + ds.rasterSize.x * gt[1],
+      minY: gt[3] + ds.rasterSize.y * gt[5],
+      maxY: gt[3]
+    }
+  }
+
+  describe('add()', () => {
+    it('should add entries', () => {
+      const index = new gdal.RasterIndex()
+      assert.equal(index.count, 0)
+      assert.equal(index.add('a.tif', { minX: 0, minY: 0, maxX: 1, maxY: 1 }), 0)
+      assert.equal(index.add('b.tif', { minX: 1, minY: 1, maxX: 2, maxY: 2 }, { time: new Date(1000) }), 1)
+      assert.equal(index.count, 2)
+      assert.deepEqual(index.get(1), {
+        id: 1,
+        path: 'b.tif',
+        bounds: { minX: 1, minY: 1, maxX: 2, maxY: 2 },
+        srs: null,
+        resolution: null,
+        time: 1000
+      })
+    })
+    it('should throw on invalid bounds', () => {
+      const index = new gdal.RasterIndex()
+      assert.throws(() => index.add('a.tif', { minX: 1, minY: 0, maxX: 0, maxY: 1 }), /Invalid bounds/)
+      assert.throws(() => index.add('a.tif', {} as gdal.Envelope))
+      assert.throws(() => index.get(0), /Invalid id/)
+    })
+  })
+
+  describe('search()', () => {
+    it('should find the intersecting footprints', () => {
+      const index = createGrid()
+      assert.deepEqual(ids(index.search({ minX: 2.5, minY: 3.5, maxX: 3.5, maxY: 3.6 })), [ 32, 33 ])
+      assert.lengthOf(index.search({ minX: -100, minY: -100, maxX: 100, maxY: 100 }), 100)
+      assert.lengthOf(index.search({ minX: 20, minY: 20, maxX: 30, maxY: 30 }), 0)
+    })
+    it('should support points', () => {
+      const index = createGrid()
+      const r = index.search({ x: 5.5, y: 7.5 })
+      assert.lengthOf(r, 1)
+      assert.equal(r[0].path, 'tile_5_7.tif')
+      assert.equal(r[0].srs, 'EPSG:3857')
+      assert.deepEqual(r[0].resolution, { x: 0.01, y: 0.01 })
+    })
+    it('should filter by time', () => {
+      const index = createGrid()
+      const r = index.search({ minX: 0, minY: 0.5, maxX: 10, maxY: 0.5 },
+        { from: new Date(Date.UTC(2020, 0, 3)), to: Date.UTC(2020, 0, 4) })
+      assert.deepEqual(ids(r), [ 2, 3 ])
+    })
+    it('should see the entries added after a search', () => {
+      const index = createGrid()
+      assert.lengthOf(index.search({ x: 20, y: 20 }), 0)
+      index.add('far.tif', { minX: 19, minY: 19, maxX: 21, maxY: 21 })
+      assert.deepEqual(ids(index.search({ x: 20, y: 20 })), [ 100 ])
+    })
+  })
+
+  describe('save()/load()', () => {
+    it('should preserve the index', () => {
+      const index = createGrid()
+      index.save('/vsimem/index.idx')
+      const loaded = gdal.RasterIndex.load('/vsimem/index.idx')
+      gdal.vsimem.release('/vsimem/index.idx')
+      assert.equal(loaded.count, 100)
+      const query = { minX: 2.5, minY: 3.5, maxX: 6.5, maxY: 4.5 }
+      assert.deepEqual(ids(loaded.search(query)), ids(index.search(query)))
+      assert.deepEqual(loaded.get(42), index.get(42))
+    })
+    it('should throw on corrupted files', () => {
+      createGrid().save('/vsimem/corrupted.idx')
+      const original = gdal.vsimem.release('/vsimem/corrupted.idx')
+      // header, srs_count, the empty unknown SRS, then 'EPSG:3857' and the entry count
+      const srsCount = 16, srsLength = 24, entryCount = 37
+      for (const offset of [ srsCount, srsLength, entryCount ]) {
+        const data = Buffer.from(original)
+        data.writeUInt32LE(0xffffffff, offset)
+        gdal.vsimem.set(data, '/vsimem/corrupted.idx')
+        assert.throws(() => gdal.RasterIndex.load('/vsimem/corrupted.idx'), /Truncated or corrupted/)
+        gdal.vsimem.release('/vsimem/corrupted.idx')
+      }
+    })
+    it('should throw on invalid files', () => {
+      assert.throws(() => gdal.RasterIndex.load(sample), /Not a RasterIndex file/)
+      assert.throws(() => gdal.RasterIndex.load('/vsimem/nonexistent.idx'))
+    })
+  })
+
+  describe('save()/loadAsync()', () => {
+    it('should preserve the index', async () => {
+      const index = createGrid()
+      await index.saveAsync('/vsimem/index_async.idx')
+      const loaded = await gdal.RasterIndex.loadAsync('/vsimem/index_async.idx')
+      gdal.vsimem.release('/vsimem/index_async.idx')
+      assert.deepEqual(ids(loaded.search({ x: 0.5, y: 0.5 })), [ 0 ])
+    })
+  })
+
+  describe('fromFiles()', () => {
+    it('should read the footprints of the files', () => {
+      const index = gdal.RasterIndex.fromFiles([ sample, multiband ], { threads: 2 })
+      assert.equal(index.count, 2)
+      const entry = index.get(0)
+      assert.equal(entry.path, sample)
+      assert.deepEqual(entry.bounds, boundsOf(sample))
+      assert.isString(entry.srs)
+      const gt = gdal.open(sample).geoTransform as number[]
+      assert.closeTo((entry.resolution as gdal.xyz).x, gt[1], 1e-9)
+      assert.deepEqual(index.get(1).bounds, boundsOf(multiband))
+      const b = boundsOf(sample)
+      assert.deepEqual(index.search({ x: (b.minX + b.maxX) / 2, y: (b.minY + b.maxY) / 2 }).map((e) => e.path),
+        [ sample ])
+    })
+    it('should throw on invalid files', () => {
+      assert.throws(() => gdal.RasterIndex.fromFiles([ sample, 'nonexistent.tif' ]), /nonexistent/)
+    })
+  })
+
+  describe('fromFilesAsync()', () => {
+    it('should read the footprints of the files', async () => {
+      const index = await gdal.RasterIndex.fromFilesAsync([ sample, sample, multiband ])
+      assert.equal(index.count, 3)
+      assert.deepEqual(index.get(1).bounds, boundsOf(sample))
+    })
+  })
+
+  describe('fromLayer()', () => {
+    const createLayer = () => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const layer = ds.layers.create('index', gdal.SpatialReference.fromEPSG(4326), gdal.wkbPolygon)
+      layer.fields.add(new gdal.FieldDefn('location', gdal.OFTString))
+      layer.fields.add(new gdal.FieldDefn('date', gdal.OFTDateTime))
+      for (let i = 0; i < 3; i++) {
+        const feature = new gdal.Feature(layer)
+        feature.fields.set('location', `tile_${i}.tif`)
+        feature.fields.set('date', `2020-01-0${i + 1}T00:00:00Z`)
+        feature.setGeometry(gdal.Geometry.fromWKT(`POLYGON ((${i} 0, ${i + 1} 0, ${i + 1} 1, ${i} 1, ${i} 0))`))
+        layer.features.add(feature)
+      }
+      return layer
+    }
+
+    it('should read a tile index layer', () => {
+      const index = gdal.RasterIndex.fromLayer(createLayer(), { timeField: 'date' })
+      assert.equal(index.count, 3)
+      const r = index.search({ x: 1.5, y: 0.5 })
+      assert.lengthOf(r, 1)
+      assert.equal(r[0].path, 'tile_1.tif')
+      assert.equal(r[0].srs, 'EPSG:4326')
+      assert.equal(r[0].time, Date.UTC(2020, 0, 2))
+      assert.deepEqual(r[0].bounds, { minX: 1, minY: 0, maxX: 2, maxY: 1 })
+    })
+    it('should throw on missing fields', () => {
+      assert.throws(() => gdal.RasterIndex.fromLayer(createLayer(), { locationField: 'path' }), /Location field/)
+      assert.throws(() => gdal.RasterIndex.fromLayer(createLayer(), { timeField: 'time' }), /Time field/)
+    })
+  })
+
+  describe('fromLayerAsync()', () => {
+    it('should read a tile index layer', async () => {
+      const index = await gdal.RasterIndex.fromLayerAsync(createLayerAsync())
+      assert.equal(index.count, 1)
+      assert.isNull(index.get(0).time)
+    })
+
+    function createLayerAsync() {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const layer = ds.layers.create('index', null, gdal.wkbPolygon)
+      layer.fields.add(new gdal.FieldDefn('location', gdal.OFTString))
+      const feature = new gdal.Feature(layer)
+      feature.fields.set('location', 'tile.tif')
+      feature.setGeometry(gdal.Geometry.fromWKT('POLYGON ((0 0, 1 0, 1 1, 0 1, 0 0))'))
+      layer.features.add(feature)
+      return layer
+    }
+  })
+})
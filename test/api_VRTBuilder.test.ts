@@ -0,0 +1,166 @@
+import * as gdal from 'gdal-async'
+import { assert } from 'chai'
+import * as path from 'path'
+import * as semver from 'semver'
+
+describe('gdal.VRTBuilder', () => {
+  const sample = path.resolve(__dirname, 'data', 'sample.tif')
+  const multiband = path.resolve(__dirname, 'data', 'multiband.tif')
+
+  before(function () {
+    if (!semver.gte(gdal.version, '3.5.0')) {
+      this.skip()
+    }
+  })
+
+  it('should produce a Dataset identical to its source by default', () => {
+    const src = gdal.open(sample)
+    const builder = new gdal.VRTBuilder()
+    const band = builder.addBand()
+    assert.strictEqual(band, 1)
+    builder.addSimpleSource(band, src.bands.get(1))
+    assert.strictEqual(builder.bandCount, 1)
+
+    const ds = builder.build()
+    assert.strictEqual(ds.driver.description, 'VRT')
+    assert.deepEqual(ds.rasterSize, src.rasterSize)
+    assert.deepEqual(ds.geoTransform, src.geoTransform)
+    assert.isTrue(ds.srs?.isSame(src.srs as gdal.SpatialReference))
+    assert.deepEqual(ds.getMetadata(), src.getMetadata())
+    assert.strictEqual(ds.bands.get(1).dataType, src.bands.get(1).dataType)
+    assert.strictEqual(gdal.checksumImage(ds.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+  })
+
+  it('should support multiband files', () => {
+    const src = gdal.open(multiband)
+    const builder = new gdal.VRTBuilder()
+    src.bands.forEach((b) => builder.addSimpleSource(builder.addBand(), b))
+    const ds = builder.build()
+    assert.strictEqual(ds.bands.count(), src.bands.count())
+    src.bands.forEach((b) => {
+      assert.strictEqual(gdal.checksumImage(ds.bands.get(b.id)), gdal.checksumImage(b))
+    })
+  })
+
+  it('should apply a pixel function with arguments', () => {
+    const src = gdal.open(sample)
+    const builder = new gdal.VRTBuilder()
+    const band = builder.addBand({
+      pixelFunc: 'inv',
+      pixelFuncArgs: { k: 3 },
+      dataType: gdal.GDT_Float32,
+      sourceTransferType: gdal.GDT_Float32
+    })
+    builder.addSimpleSource(band, src.bands.get(1))
+
+    const expected = gdal.open(gdal.wrapVRT({
+      bands: [ {
+        sources: [ src.bands.get(1) ],
+        pixelFunc: 'inv',
+        pixelFuncArgs: { k: 3 },
+        dataType: gdal.GDT_Float32,
+        sourceTransferType: gdal.GDT_Float32
+      } ]
+    }))
+
+    const ds = builder.build()
+    assert.strictEqual(ds.bands.get(1).dataType, gdal.GDT_Float32)
+    assert.deepEqual(ds.bands.get(1).pixels.read(100, 100, 16, 16), expected.bands.get(1).pixels.read(100, 100, 16, 16))
+  })
+
+  it('should support complex sources with windows and scaling', () => {
+    const src = gdal.open(sample)
+    const builder = new gdal.VRTBuilder({
+      rasterSize: { x: 64, y: 32 },
+      geoTransform: [ 0, 1, 0, 0, 0, -1 ],
+      srs: gdal.SpatialReference.fromEPSG(4326),
+      metadata: { origin: 'VRTBuilder' }
+    })
+    const band = builder.addBand({ dataType: gdal.GDT_Int16, noDataValue: -1, description: 'scaled' })
+    builder.addComplexSource(band, src.bands.get(1), {
+      srcWindow: { x: 100, y: 100, width: 32, height: 32 },
+      dstWindow: { x: 0, y: 0, width: 32, height: 32 },
+      scaleOffset: 1,
+      scaleRatio: 2
+    })
+
+    const ds = builder.build()
+    assert.deepEqual(ds.rasterSize, { x: 64, y: 32 })
+    assert.deepEqual(ds.geoTransform, [ 0, 1, 0, 0, 0, -1 ])
+    assert.isTrue(ds.srs?.isSame(gdal.SpatialReference.fromEPSG(4326)))
+    assert.strictEqual(ds.getMetadata().origin, 'VRTBuilder')
+    assert.strictEqual(ds.bands.get(1).description, 'scaled')
+    assert.strictEqual(ds.bands.get(1).noDataValue, -1)
+
+    const original = src.bands.get(1).pixels.read(100, 100, 32, 32)
+    const scaled = ds.bands.get(1).pixels.read(0, 0, 32, 32)
+    for (let i = 0; i < original.length; i++) {
+      assert.strictEqual(scaled[i], original[i] * 2 + 1)
+    }
+    // Outside of the source window
+    assert.strictEqual(ds.bands.get(1).pixels.get(48, 16), -1)
+  })
+
+  it('should build asynchronously', async () => {
+    const src = await gdal.openAsync(sample)
+    const builder = new gdal.VRTBuilder()
+    builder.addSimpleSource(builder.addBand(), await src.bands.getAsync(1))
+    const ds = await builder.buildAsync()
+    assert.instanceOf(ds, gdal.Dataset)
+    assert.strictEqual(await gdal.checksumImageAsync(await ds.bands.getAsync(1)),
+      await gdal.checksumImageAsync(await src.bands.getAsync(1)))
+  })
+
+  it('should remain usable after building', () => {
+    const src = gdal.open(multiband)
+    const builder = new gdal.VRTBuilder()
+    builder.addSimpleSource(builder.addBand(), src.bands.get(1))
+    const ds1 = builder.build()
+    builder.addSimpleSource(builder.addBand(), src.bands.get(2))
+    const ds2 = builder.build()
+    assert.strictEqual(ds1.bands.count(), 1)
+    assert.strictEqual(ds2.bands.count(), 2)
+  })
+
+  it('should throw with invalid arguments', () => {
+    const src = gdal.open(sample)
+    assert.throws(() => {
+      new gdal.VRTBuilder().build()
+    }, /rasterSize must be specified/)
+    assert.throws(() => {
+      const builder = new gdal.VRTBuilder({ rasterSize: { x: 16, y: 16 } })
+      builder.addBand()
+      builder.build()
+    }, /must specify a dataType/)
+    assert.throws(() => {
+      new gdal.VRTBuilder().addSimpleSource(1, src.bands.get(1))
+    }, /Invalid band id/)
+    assert.throws(() => {
+      new gdal.VRTBuilder().addBand({ dataType: 'Invalid' })
+    }, /Invalid data type/)
+    assert.throws(() => {
+      new gdal.VRTBuilder().addBand({ pixelFuncArgs: { k: 3 } })
+    }, /require a pixelFunc/)
+    assert.throws(() => {
+      const builder = new gdal.VRTBuilder()
+      builder.addSimpleSource(builder.addBand(), src.bands.get(1), { srcWindow: { x: 0, y: 0, width: 0, height: 1 } })
+    }, /Invalid srcWindow/)
+    assert.throws(() => {
+      const builder = new gdal.VRTBuilder()
+      builder.addSimpleSource(builder.addBand(), gdal.open('temp', 'w', 'MEM', 16, 16).bands.get(1))
+      builder.build()
+    }, /opened from a file/)
+  })
+
+  it('should reject a builder without sources', () =>
+    assert.isRejected(new gdal.VRTBuilder().buildAsync(), /rasterSize must be specified/)
+  )
+
+  it('should reject when a source has been closed', () => {
+    const src = gdal.open(sample)
+    const builder = new gdal.VRTBuilder()
+    builder.addSimpleSource(builder.addBand(), src.bands.get(1))
+    src.close()
+    return assert.isRejected(builder.buildAsync(), /already been destroyed/)
+  })
+})
@@ -3,6 +3,7 @@ import { assert } from 'chai'
 import * as path from 'path'
 import * as fs from 'fs'
 import * as cp from 'child_process'
+import * as os from 'os'
 
 if (process.env.GDAL_DATA !== undefined) {
   throw new Error(
@@ -131,6 +132,137 @@ describe('gdal', () => {
     })
   })
 
+  describe('Native Promises', () => {
+    it('should be returned by async methods called without a callback', () => {
+      const ds = gdal.open(`${__dirname}/data/sample.tif`)
+      const q = ds.bands.get(1).pixels.getAsync(200, 300)
+      assert.instanceOf(q, Promise)
+      return assert.eventually.equal(q, 10)
+    })
+    it('should be rejected on invalid arguments', () => {
+      const ds = gdal.open(`${__dirname}/data/sample.tif`)
+      /* eslint-disable-next-line @typescript-eslint/no-explicit-any */
+      return assert.isRejected((ds.bands.get(1).pixels as any).getAsync('x', 300), /x must be an integer/)
+    })
+    it('should support progress callbacks', () => {
+      const ds = gdal.open(`${__dirname}/data/sample.tif`)
+      return assert.eventually.propertyVal(ds.bands.get(1).pixels.readAsync(0, 0, 64, 64, undefined, {
+        progress_cb: () => undefined
+      }), 'length', 64 * 64)
+    })
+    it('should carry the GDAL errors of the operation when rejected', () =>
+      gdal.openAsync('notfound').then(() => assert.fail('should have been rejected'), (e) => {
+        assert.isArray(e.cplErrors)
+        assert.isNotEmpty(e.cplErrors)
+        assert.propertyVal(e.cplErrors[e.cplErrors.length - 1], 'level', gdal.CE_Failure)
+        assert.propertyVal(e.cplErrors[e.cplErrors.length - 1], 'code', gdal.CPLE_OpenFailed)
+      })
+    )
+    it('should not execute operations inline by default', () => {
+      // eslint-disable-next-line @typescript-eslint/no-explicit-any
+      assert.equal((gdal as any).asyncInlineThreshold, 0)
+    })
+    describe('inline execution of cheap operations', () => {
+      /* eslint-disable @typescript-eslint/no-explicit-any */
+      beforeEach(() => {
+        (gdal as any).asyncInlineThreshold = 20
+      })
+      afterEach(() => {
+        (gdal as any).asyncInlineThreshold = 0
+      })
+      it('should still resolve Promises', async () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        for (let i = 0; i < 32; i++) {
+          const q = band.pixels.getAsync(200, 300)
+          assert.instanceOf(q, Promise)
+          assert.equal(await q, 10)
+        }
+      })
+      it('should still reject Promises', async () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        for (let i = 0; i < 16; i++) await band.pixels.getAsync(200, 300)
+        await assert.isRejected(band.pixels.getAsync(2000, 3000))
+      })
+      it('should be configurable', () => {
+        (gdal as any).asyncInlineThreshold = 0
+        assert.equal((gdal as any).asyncInlineThreshold, 0)
+        assert.throws(() => {
+          (gdal as any).asyncInlineThreshold = -1
+        }, /must be a positive integer/)
+      })
+      /* eslint-enable @typescript-eslint/no-explicit-any */
+    })
+  })
+
+  describe('trace events', () => {
+    it('should be emitted by the asynchronous operations', function () {
+      this.timeout(20000)
+      const gdalJS = fs.existsSync('./lib/gdal.js') ? './lib/gdal.js' : 'gdal-async'
+      const trace = path.resolve(os.tmpdir(), `node_gdal_trace_${process.pid}.json`)
+      const script = `const gdal = require('${gdalJS}');
+        gdal.openAsync('${__dirname.replace(/\\/g, '/')}/data/sample.tif')
+          .then((ds) => ds.bands.get(1).pixels.readAsync(0, 0, 64, 64))
+          .then(() => { delete gdal.drivers; global.gc() })`
+      cp.execFileSync(process.execPath, [
+        '--expose_gc', '--trace-event-categories', 'node-gdal', '--trace-event-file-pattern', trace, '-e', script
+      ])
+      try {
+        const events = JSON.parse(fs.readFileSync(trace, 'utf8')).traceEvents
+          .filter((e: { cat: string }) => e.cat === 'node-gdal')
+        const read = events.filter((e: { name: string }) => e.name === 'RasterBandPixels::readAsync')
+        assert.deepEqual(read.map((e: { ph: string }) => e.ph), [ 'B', 'E' ])
+        assert.propertyVal(read[0].args, 'bytes', 64 * 64)
+        assert.isAbove(read[0].args.uid, 0)
+        assert.isNotEmpty(events.filter((e: { name: string }) => e.name === 'lockDataset'))
+      } finally {
+        fs.unlinkSync(trace)
+      }
+    })
+  })
+
+  describe('cache', () => {
+    it('stats() should count the block cache hits and misses', () => {
+      const ds = gdal.open(`${__dirname}/data/sample.tif`)
+      const band = ds.bands.get(1)
+      gdal.cache.trackStats(true)
+      try {
+        gdal.cache.resetStats()
+        band.pixels.read(0, 0, 984, 16)
+        band.pixels.read(0, 8, 984, 16)
+        // resampled reads are not counted
+        band.pixels.read(0, 0, 984, 16, undefined, { buffer_width: 492, buffer_height: 8 })
+        const stats = gdal.cache.stats()
+        assert.equal(stats.misses, 3)
+        assert.equal(stats.hits, 1)
+        assert.isAtLeast(stats.used, 3 * 984 * 8)
+        assert.isAtLeast(stats.max, stats.used)
+      } finally {
+        gdal.cache.trackStats(false)
+      }
+    })
+    it('stats() should not count anything when the tracking is disabled', () => {
+      const ds = gdal.open(`${__dirname}/data/sample.tif`)
+      gdal.cache.resetStats()
+      ds.bands.get(1).pixels.read(0, 0, 984, 16)
+      const stats = gdal.cache.stats()
+      assert.equal(stats.misses, 0)
+      assert.equal(stats.hits, 0)
+      assert.throws(() => gdal.cache.trackStats(undefined as unknown as boolean), /enable/)
+    })
+    it('setMax() should set the maximum size of the block cache', () => {
+      const max = gdal.cache.stats().max
+      try {
+        gdal.cache.setMax(64 * 1024 * 1024)
+        assert.equal(gdal.cache.stats().max, 64 * 1024 * 1024)
+      } finally {
+        gdal.cache.setMax(max)
+      }
+      assert.throws(() => gdal.cache.setMax(-1), /must be positive/)
+    })
+  })
+
   it('should handle exceptions in progress callbacks', () => {
     const driver = gdal.drivers.get('MEM')
     const outputFilename = ''
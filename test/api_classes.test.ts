@@ -57,6 +57,10 @@ const create31 = {
   MDArray: () => gdal.open(path.resolve(__dirname, 'data', 'gfs.t00z.alnsf.nc'), 'mr').root.arrays.get(1)
 }
 
+const create35 = {
+  VRTBuilder: []
+}
+
 describe('Class semantics', () => {
   afterEach(() => void global.gc!())
 
@@ -64,6 +68,9 @@ describe('Class semantics', () => {
   if (semver.gte(gdal.version, '3.1.0')) {
     Object.assign(klasses, create31)
   }
+  if (semver.gte(gdal.version, '3.5.0')) {
+    Object.assign(klasses, create35)
+  }
 
   for (const name in klasses) {
     it(`gdal.${name}`, () => {
@@ -595,6 +595,16 @@ describe('gdal.Dataset', () => {
           const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
           assert.isNull(ds.rasterSize)
         })
+        it('should not wait for pending async operations on read-only datasets', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const q = band.pixels.readAsync(0, 0, 984, 804)
+          assert.deepEqual(ds.rasterSize, { x: 984, y: 804 })
+          assert.equal(ds.bands.count(), 1)
+          assert.deepEqual(band.size, { x: 984, y: 804 })
+          assert.equal(band.dataType, gdal.GDT_Byte)
+          return assert.isFulfilled(q)
+        })
         it('should throw if dataset is already closed', () => {
           const ds = gdal.open(`${__dirname}/data/dem_azimuth50_pa.img`)
           ds.close()
@@ -884,6 +894,118 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.executeSQLAsync('SELECT name FROM sample'))
       })
     })
+    describe('releaseResultSet()', () => {
+      it('should release the results of executeSQL', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = ds.executeSQL('SELECT name FROM sample')
+        ds.releaseResultSet(result_set)
+        assert.throws(() => {
+          result_set.fields.getNames()
+        }, /destroyed/)
+      })
+      it('should release the results asynchronously', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = await ds.executeSQLAsync('SELECT name FROM sample')
+        await ds.releaseResultSetAsync(result_set)
+        assert.throws(() => {
+          result_set.fields.getNames()
+        }, /destroyed/)
+      })
+      it('should throw on a regular layer', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        assert.throws(() => {
+          ds.releaseResultSet(ds.layers.get(0))
+        }, /not an SQL result set/)
+      })
+    })
+    describe('queryAsync()', () => {
+      it('should iterate over the results by batches', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const count = ds.layers.get(0).features.count()
+        const names: string[] = []
+        let batches = 0
+        for await (const batch of ds.queryAsync('SELECT name FROM sample', { batchSize: 10 })) {
+          const rows = batch as gdal.FeatureRow[]
+          assert.isAtMost(rows.length, 10)
+          assert.deepEqual(Object.keys(rows[0].fields), [ 'name' ])
+          assert.instanceOf(rows[0].geometry, gdal.Geometry)
+          names.push(...rows.map((r) => r.fields.name))
+          batches++
+        }
+        assert.lengthOf(names, count)
+        assert.equal(batches, Math.ceil(count / 10))
+      })
+      it('should support columnar batches', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const query = ds.queryAsync('SELECT name, COUNT(*) AS n FROM sample GROUP BY name',
+          { columnar: true, geometry: false })
+        let total = 0
+        for await (const batch of query) {
+          const columns = batch as gdal.FeatureColumns
+          assert.isUndefined(columns.geometry)
+          total += columns.fields.n.reduce((a: number, x: number) => a + x, 0)
+        }
+        assert.equal(total, ds.layers.get(0).features.count())
+      })
+      it('should apply the spatial filter and the dialect', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const layer = ds.layers.get(0)
+        const filter = gdal.Geometry.fromWKT('POLYGON((-111 41,-104 41,-104 43,-111 43,-111 41))')
+        layer.setSpatialFilter(filter)
+        const expected = layer.features.count()
+        layer.setSpatialFilter(null)
+        let count = 0
+        for await (const batch of ds.queryAsync('SELECT * FROM sample', { spatialFilter: filter, dialect: 'OGRSQL' })) {
+          count += (batch as gdal.FeatureRow[]).length
+        }
+        assert.equal(count, expected)
+      })
+      it('should allow interrupting the iteration', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const query = ds.queryAsync('SELECT * FROM sample', { batchSize: 2 })
+        const first = await query.next()
+        assert.isFalse(first.done)
+        assert.deepEqual(await query.return?.(), { done: true, value: undefined })
+        assert.deepEqual(await query.next(), { done: true, value: undefined })
+      })
+      it('should reject on invalid SQL', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        return assert.isRejected(ds.queryAsync('SELECT * FROM nosuchtable').next())
+      })
+      it('should throw on invalid arguments', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        assert.throws(() => {
+          ds.queryAsync('SELECT * FROM sample', { batchSize: 0 })
+        }, /positive integer/)
+      })
+    })
+    describe('ioStats()', () => {
+      it('should count the I/O operations of datasets opened with the "s" mode', () => {
+        const ds = gdal.open(path.join(__dirname, 'data', 'sample.tif'), 'rs')
+        ds.ioStats(true)
+        const band = ds.bands.get(1)
+        band.pixels.read(0, 0, 984, 16)
+        band.pixels.read(0, 8, 984, 16)
+        const stats = ds.ioStats(true)
+        assert.isAbove(stats.bytesRead, 0)
+        assert.isAbove(stats.reads, 0)
+        assert.equal(stats.blockDecodes, 3)
+        assert.equal(stats.cacheHits, 1)
+        assert.equal(stats.bytesWritten, 0)
+        assert.deepEqual(ds.ioStats(), {
+          bytesRead: 0, reads: 0, seeks: 0, bytesWritten: 0, writes: 0, blockDecodes: 0, cacheHits: 0
+        })
+      })
+      it('should support asynchronous opening', async () => {
+        const ds = await gdal.openAsync(path.join(__dirname, 'data', 'sample.tif'), 'rs')
+        await ds.bands.get(1).pixels.readAsync(0, 0, 984, 8)
+        assert.equal(ds.ioStats().blockDecodes, 1)
+      })
+      it('should throw if the dataset was not opened with the "s" mode', () => {
+        const ds = gdal.open(path.join(__dirname, 'data', 'sample.tif'))
+        assert.throws(() => ds.ioStats(), /"s" mode/)
+      })
+    })
     describe('getFileList()', () => {
       it('should return list of filenames', () => {
         const ds = gdal.open(path.join(__dirname, 'data', 'sample.vrt'))
@@ -955,6 +1077,57 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.getMetadataAsync())
       })
     })
+    describe('describe()', () => {
+      it('should return the dataset and the bands properties', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const desc = ds.describe()
+        assert.deepEqual(desc.rasterSize, ds.rasterSize)
+        assert.deepEqual(desc.geoTransform, ds.geoTransform)
+        assert.isTrue(desc.srs?.isSame(ds.srs as gdal.SpatialReference))
+        assert.equal(desc.driver, 'GTiff')
+        assert.equal(desc.bandCount, 1)
+        assert.lengthOf(desc.bands as gdal.BandDescription[], 1)
+        const band = ds.bands.get(1)
+        const bandDesc = (desc.bands as gdal.BandDescription[])[0]
+        assert.equal(bandDesc.id, 1)
+        assert.deepEqual(bandDesc.size, band.size)
+        assert.deepEqual(bandDesc.blockSize, { x: 984, y: 8 })
+        assert.equal(bandDesc.dataType, gdal.GDT_Byte)
+        assert.equal(bandDesc.noDataValue, band.noDataValue)
+        assert.isUndefined(bandDesc.overviews)
+        assert.isUndefined(desc.metadata)
+      })
+      it('should support options', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const desc = ds.describe({ bands: false, metadata: true })
+        assert.isUndefined(desc.bands)
+        assert.propertyVal(desc.metadata, 'AREA_OR_POINT', 'Area')
+      })
+      it('should throw if dataset already closed', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds.close()
+        assert.throws(() => {
+          ds.describe()
+        })
+      })
+    })
+    describe('describeAsync()', () => {
+      it('should return the dataset and the bands properties', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        return ds.describeAsync({ overviews: true }).then((desc) => {
+          assert.deepEqual(desc.rasterSize, { x: 984, y: 804 })
+          assert.lengthOf(desc.bands as gdal.BandDescription[], 1)
+          const bandDesc = (desc.bands as gdal.BandDescription[])[0]
+          assert.isArray(bandDesc.overviews)
+          assert.lengthOf(bandDesc.overviews as gdal.xyz[], bandDesc.overviewCount)
+        })
+      })
+      it('should reject if dataset already closed', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds.close()
+        return assert.isRejected(ds.describeAsync())
+      })
+    })
     describe('setMetadata()', () => {
       it('should set the metadata', () => {
         const ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
@@ -997,6 +1170,107 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.setMetadataAsync({}))
       })
     })
+    describe('adviseRead()', () => {
+      it('should accept a window and a list of bands', () => {
+        const ds = gdal.open(`${__dirname}/data/multiband.tif`)
+        ds.adviseRead(0, 0, 64, 64)
+        ds.adviseRead(0, 0, 64, 64, { bands: [ 1 ], buffer_width: 32, buffer_height: 32 })
+      })
+      it('should throw on an invalid band', () => {
+        const ds = gdal.open(`${__dirname}/data/multiband.tif`)
+        assert.throws(() => ds.adviseRead(0, 0, 64, 64, { bands: [ 99 ] }), /Invalid band number/)
+      })
+      it('should throw on an invalid window', () => {
+        const ds = gdal.open(`${__dirname}/data/multiband.tif`)
+        assert.throws(() => ds.adviseRead(0, 0, 64, -1), /Invalid window/)
+        assert.throws(() => ds.adviseRead(ds.rasterSize.x, 0, 64, 64), /Invalid window/)
+        assert.throws(() => ds.adviseRead(0, 0, 64, 64, { buffer_height: 0 }), /Invalid buffer size/)
+      })
+    })
+    describe('adviseReadAsync()', () => {
+      it('should accept a window', () => {
+        const ds = gdal.open(`${__dirname}/data/multiband.tif`)
+        return assert.isFulfilled(ds.adviseReadAsync(0, 0, 64, 64, { bands: [ 1 ] }))
+      })
+    })
+    describe('render()', () => {
+      const decode = (image: Buffer, ext: string) => {
+        const file = `/vsimem/render_test.${String(Math.random()).substring(2)}.${ext}`
+        gdal.vsimem.set(image, file)
+        const ds = gdal.open(file)
+        const r = {
+          bands: ds.bands.count(),
+          size: ds.rasterSize,
+          pixels: ds.bands.map((band) => band.pixels.read(0, 0, ds.rasterSize.x, ds.rasterSize.y))
+        }
+        ds.close()
+        gdal.vsimem.release(file)
+        return r
+      }
+      const createDataset = () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 4, 2, 1, gdal.GDT_Int16)
+        ds.bands.get(1).pixels.write(0, 0, 4, 2, new Int16Array([ -10, 0, 100, 300, 0, 1, 2, 3 ]))
+        return ds
+      }
+
+      it('should encode a window to PNG', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const png = ds.render({ x: 10, y: 20, width: 32, height: 16 })
+        assert.instanceOf(png, Buffer)
+        assert.deepEqual([ ...png.subarray(0, 4) ], [ 0x89, 0x50, 0x4e, 0x47 ])
+        const image = decode(png, 'png')
+        assert.deepEqual(image.size, { x: 32, y: 16 })
+        assert.deepEqual(image.pixels[0], ds.bands.get(1).pixels.read(10, 20, 32, 16))
+      })
+      it('should clamp or scale the values', () => {
+        const ds = createDataset()
+        const window = { x: 0, y: 0, width: 4, height: 2 }
+        assert.deepEqual([ ...decode(ds.render(window), 'png').pixels[0] ], [ 0, 0, 100, 255, 0, 1, 2, 3 ])
+        assert.deepEqual([ ...decode(ds.render(window, { scale: [ 0, 300 ] }), 'png').pixels[0].subarray(0, 4) ],
+          [ 0, 0, 85, 255 ])
+      })
+      it('should apply a palette', () => {
+        const ds = createDataset()
+        const palette = new gdal.ColorTable(gdal.GPI_RGB)
+        palette.set(1, { c1: 255, c2: 0, c3: 0, c4: 255 })
+        palette.set(2, { c1: 0, c2: 255, c3: 0, c4: 0 })
+        const image = decode(ds.render({ x: 0, y: 1, width: 4, height: 1 }, { colorTable: palette }), 'png')
+        assert.equal(image.bands, 4)
+        assert.deepEqual(image.pixels.map((p) => p[1]), [ 255, 0, 0, 255 ])
+        assert.deepEqual(image.pixels.map((p) => p[2]), [ 0, 255, 0, 0 ])
+      })
+      it('should resize the window and support other formats', () => {
+        const ds = gdal.open(`${__dirname}/data/multiband.tif`)
+        const jpeg = ds.render({ x: 0, y: 0, width: 64, height: 64 },
+          { bands: [ 1, 2, 3 ], outSize: { x: 32, y: 32 }, format: 'JPEG', creationOptions: { QUALITY: 90 },
+            resampling: 'Average' })
+        assert.deepEqual([ ...jpeg.subarray(0, 2) ], [ 0xff, 0xd8 ])
+        const image = decode(jpeg, 'jpg')
+        assert.equal(image.bands, 3)
+        assert.deepEqual(image.size, { x: 32, y: 32 })
+      })
+      it('should throw on invalid arguments', () => {
+        const ds = createDataset()
+        const window = { x: 0, y: 0, width: 4, height: 2 }
+        assert.throws(() => ds.render({ x: 0, y: 0, width: 0, height: 2 }), /Invalid window/)
+        assert.throws(() => ds.render(window, { format: 'nonexistent' }), /format must be/)
+        assert.throws(() => ds.render(window, { bands: [ 2 ] }), /Invalid band number/)
+        assert.throws(() => ds.render(window, { scale: [ [ 0, 1 ], [ 0, 1 ] ] }), /one range per band/)
+      })
+    })
+    describe('renderAsync()', () => {
+      it('should encode a window to PNG', async () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const png = await ds.renderAsync({ x: 0, y: 0, width: 64, height: 64 }, { outSize: { x: 16, y: 16 } })
+        assert.instanceOf(png, Buffer)
+        assert.deepEqual([ ...png.subarray(0, 4) ], [ 0x89, 0x50, 0x4e, 0x47 ])
+      })
+      it('should reject on error', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        return assert.isRejected(ds.renderAsync({ x: 0, y: 0, width: 64, height: 64 }, { bands: [ 5 ] }),
+          /Invalid band number/)
+      })
+    })
     describe('buildOverviews()', () => {
       it('should generate overviews for all bands', () => {
         const tempFile = fileUtils.clone(`${__dirname}/data/multiband.tif`)
@@ -1168,6 +1442,51 @@ describe('gdal.Dataset', () => {
         gdal.vsimem.release(tempFile)
         return assert.isRejected(ds.buildOverviewsAsync('NEAREST', [ 2, 4, 8 ]))
       })
+      describe('w/threads and cascade options', () => {
+        it('should compute every level from the previous one', () => {
+          const tempFile = fileUtils.clone(`${__dirname}/data/multiband.tif`)
+          const ds = gdal.open(tempFile, 'r+')
+          const messages = new Set<string>()
+          let last = 0
+          return assert.isFulfilled(ds.buildOverviewsAsync('AVERAGE', [ 8, 2, 4 ], undefined, {
+            threads: 2,
+            cascade: true,
+            progress_cb: (complete, msg) => {
+              assert.isAtLeast(complete, last)
+              last = complete
+              messages.add(msg)
+            }
+          }).then(() => {
+            assert.sameMembers([ ...messages ], [ 'overview level 2', 'overview level 4', 'overview level 8' ])
+            assert.closeTo(last, 1, 1e-6)
+            ds.bands.forEach((band) => {
+              assert.equal(band.overviews.count(), 3)
+              assert.sameMembers(band.overviews.map((overview) => overview.size.x),
+                [ ds.rasterSize.x / 2, ds.rasterSize.x / 4, ds.rasterSize.x / 8 ])
+              band.overviews.forEach((overview) => assert.isAbove(gdal.checksumImage(overview), 0))
+            })
+            ds.close()
+            gdal.vsimem.release(tempFile)
+          }))
+        })
+        it('should accept ALL_CPUS', () => {
+          const tempFile = fileUtils.clone(`${__dirname}/data/sample.tif`)
+          const ds = gdal.open(tempFile, 'r+')
+          ds.buildOverviews('NEAREST', [ 2, 4 ], undefined, { threads: 'ALL_CPUS' })
+          assert.equal(ds.bands.get(1).overviews.count(), 2)
+          ds.close()
+          gdal.vsimem.release(tempFile)
+        })
+        it('should throw on invalid number of threads', () => {
+          const tempFile = fileUtils.clone(`${__dirname}/data/sample.tif`)
+          const ds = gdal.open(tempFile, 'r+')
+          assert.throws(() => {
+            ds.buildOverviews('NEAREST', [ 2, 4 ], undefined, { threads: 0 })
+          }, /threads must be a positive integer/)
+          ds.close()
+          gdal.vsimem.release(tempFile)
+        })
+      })
     })
   })
   describe('setGCPs()', () => {
@@ -1262,4 +1581,46 @@ describe('gdal.Dataset', () => {
       }, /already been destroyed/)
     })
   })
+  describe('fromTypedArrays()', () => {
+    it('should create a dataset sharing the memory of the arrays', () => {
+      const red = new Uint8Array(20 * 10).fill(1)
+      const height = new Float32Array(20 * 10).map((_, i) => i)
+      const ds = gdal.Dataset.fromTypedArrays({
+        width: 20,
+        height: 10,
+        bands: [ red, height ],
+        geoTransform: [ 100, 1, 0, 200, 0, -1 ],
+        srs: gdal.SpatialReference.fromEPSG(4326)
+      })
+      assert.equal(ds.driver.description, 'MEM')
+      assert.deepEqual(ds.rasterSize, { x: 20, y: 10 })
+      assert.deepEqual(ds.geoTransform, [ 100, 1, 0, 200, 0, -1 ])
+      assert.isTrue((ds.srs as gdal.SpatialReference).isSame(gdal.SpatialReference.fromEPSG(4326)))
+      assert.equal(ds.bands.get(1).dataType, gdal.GDT_Byte)
+      assert.equal(ds.bands.get(2).dataType, gdal.GDT_Float32)
+      assert.deepEqual(ds.bands.get(2).pixels.read(0, 0, 20, 10), height)
+
+      // no copy in either direction
+      red[21] = 42
+      assert.equal(ds.bands.get(1).pixels.get(1, 1), 42)
+      ds.bands.get(1).pixels.set(2, 1, 7)
+      assert.equal(red[22], 7)
+      ds.close()
+    })
+    it('should keep the arrays alive as long as the dataset', () => {
+      const ds = gdal.Dataset.fromTypedArrays({ width: 64, height: 64, bands: [ new Int16Array(64 * 64).fill(-3) ] })
+      global.gc!()
+      assert.equal(ds.bands.get(1).pixels.get(63, 63), -3)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => gdal.Dataset.fromTypedArrays({ width: 10, height: 10, bands: [] }), /at least one/)
+      assert.throws(() => gdal.Dataset.fromTypedArrays({ width: 10, height: 10, bands: [ new Uint8Array(99) ] }),
+        /greater than or equal to 100/)
+      assert.throws(() => gdal.Dataset.fromTypedArrays({ width: 0, height: 10, bands: [ new Uint8Array(1) ] }),
+        /must be positive/)
+      assert.throws(() => gdal.Dataset.fromTypedArrays({
+        width: 10, height: 10, bands: [ new Uint8Array(100) ], geoTransform: [ 0, 1 ]
+      }), /6 elements/)
+    })
+  })
 })
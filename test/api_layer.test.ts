@@ -495,6 +495,48 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('nextBatch()', () => {
+        it('should return the next features as plain objects', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const expected = layer.features.get(1).fields.toObject()
+            layer.features.first()
+            const batch = layer.features.nextBatch(5) as gdal.FeatureRow[]
+            assert.equal(layer.features.next().fid, 6)
+            assert.lengthOf(batch, 5)
+            assert.equal(batch[0].fid, 1)
+            assert.deepEqual(batch[0].fields, expected)
+            assert.instanceOf(batch[0].geometry, gdal.Geometry)
+          })
+        })
+        it('should support columnar batches without geometries', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            const expected = layer.features.get(1).fields.get('name')
+            layer.features.first()
+            const batch = layer.features.nextBatch(count, { columnar: true, geometry: false }) as gdal.FeatureColumns
+            assert.lengthOf(layer.features.nextBatch(count) as gdal.FeatureRow[], 0)
+            assert.lengthOf(batch.fid, count - 1)
+            assert.isUndefined(batch.geometry)
+            assert.sameMembers(Object.keys(batch.fields), layer.fields.getNames())
+            assert.equal(batch.fields.name[0], expected)
+          })
+        })
+        it('should throw on invalid count', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.nextBatch(0)
+            }, /positive integer/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.nextBatch(10)
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('first()', () => {
         it('should return a Feature and reset the iterator', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
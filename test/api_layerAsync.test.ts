@@ -442,6 +442,137 @@ describe('gdal.LayerAsync', () => {
       })
     })
 
+    describe('getExtentAsync()', () => {
+      it('should return Envelope', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer, file) => {
+          const actual_envelope = await layer.getExtentAsync()
+          assert.instanceOf(actual_envelope, gdal.Envelope)
+          assert.closeTo(actual_envelope.minX, -111.05687488399991, 0.00001)
+          assert.closeTo(actual_envelope.minY, 40.99549316200006, 0.00001)
+          assert.closeTo(actual_envelope.maxX, -104.05224885499985, 0.00001)
+          assert.closeTo(actual_envelope.maxY, 45.00589722600017, 0.00001)
+          cleanupRead(dataset, file)
+        })
+      )
+      it('should support callbacks', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) =>
+          new Promise<void>((resolve, reject) => {
+            layer.getExtentAsync(true, (e, r) => {
+              try {
+                assert.isNull(e)
+                assert.instanceOf(r, gdal.Envelope)
+                resolve()
+              } catch (err) {
+                reject(err)
+              }
+            })
+          })
+        )
+      )
+      it('should reject if dataset is destroyed', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+          dataset.close()
+          return assert.isRejected(layer.getExtentAsync(), /already been destroyed/)
+        })
+      )
+    })
+
+    describe('setSpatialFilterAsync()', () => {
+      it('should accept 4 numbers', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer) => {
+          const count_before = await layer.features.countAsync()
+          await layer.setSpatialFilterAsync(-111, 41, -104, 43)
+          const count_after = await layer.features.countAsync()
+          assert.isBelow(count_after, count_before)
+          await layer.setSpatialFilterAsync(null)
+          assert.equal(await layer.features.countAsync(), count_before)
+        })
+      )
+      it('should accept Geometry', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer) => {
+          const count_before = await layer.features.countAsync()
+          const filter = gdal.Geometry.fromWKT('POLYGON((-111 41,-104 41,-104 43,-111 43,-111 41))')
+          await layer.setSpatialFilterAsync(filter)
+          assert.isBelow(await layer.features.countAsync(), count_before)
+          const result = await layer.getSpatialFilterAsync()
+          assert.instanceOf(result, gdal.Polygon)
+          assert.isTrue(result.equals(filter))
+        })
+      )
+      it('should reject if dataset is destroyed', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+          dataset.close()
+          return assert.isRejected(layer.setSpatialFilterAsync(-111, 41, -104, 43), /already been destroyed/)
+        })
+      )
+    })
+
+    describe('setAttributeFilterAsync()', () => {
+      it('should filter layer by expression', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer) => {
+          const count_before = await layer.features.countAsync()
+          await layer.setAttributeFilterAsync("name = 'Park'")
+          assert.isBelow(await layer.features.countAsync(), count_before)
+          await layer.setAttributeFilterAsync(null)
+          assert.equal(await layer.features.countAsync(), count_before)
+        })
+      )
+      it('should reject on an invalid expression', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) =>
+          assert.isRejected(layer.setAttributeFilterAsync('nosuchfield = 1'))
+        )
+      )
+    })
+
+    describe('cached extent and count', () => {
+      it('should be invalidated by writes', () =>
+        prepare_dataset_layer_test('w', { autoclose: false }, async (dataset, layer, file) => {
+          assert.equal(await layer.features.countAsync(), 0)
+          const feature = new gdal.Feature(layer)
+          feature.setGeometry(new gdal.Point(1, 2))
+          await layer.features.addAsync(feature)
+          assert.equal(await layer.features.countAsync(), 1)
+          assert.deepInclude(await layer.getExtentAsync(), { minX: 1, maxX: 1, minY: 2, maxY: 2 })
+
+          const feature2 = new gdal.Feature(layer)
+          feature2.setGeometry(new gdal.Point(3, 4))
+          layer.features.add(feature2)
+          assert.equal(layer.features.count(), 2)
+          assert.deepInclude(layer.getExtent(), { minX: 1, maxX: 3, minY: 2, maxY: 4 })
+
+          await layer.features.removeAsync(0)
+          assert.equal(await layer.features.countAsync(), 1)
+          cleanupWrite(dataset, file)
+        })
+      )
+      it('should not wait for the Dataset', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer) => {
+          const count = await layer.features.countAsync()
+          // A slow operation holds the Dataset lock, the cached values are still available
+          const slow = dataset.executeSQLAsync('SELECT * FROM sample ORDER BY name')
+          const cached = layer.features.countAsync()
+          assert.equal(await cached, count)
+          await slow
+        })
+      )
+      it('should return the cached values synchronously', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+          const count = layer.features.count()
+          assert.equal(layer.features.count(), count)
+          const extent = layer.getExtent()
+          assert.deepEqual(layer.getExtent(), extent)
+        })
+      )
+      it('should not return an approximate value when forced', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+          const count = layer.features.count(false)
+          assert.equal(layer.features.count(true), count)
+          assert.equal(layer.features.count(true), count)
+          assert.deepEqual(layer.getExtent(true), layer.getExtent(false))
+        })
+      )
+    })
+
     describe('"features" property', () => {
       describe('getter', () => {
         it('should return LayerFeatures', () => {
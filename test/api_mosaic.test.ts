@@ -0,0 +1,140 @@
+import * as gdal from 'gdal-async'
+import { assert } from 'chai'
+import * as path from 'path'
+
+describe('gdal.mosaicRead()', () => {
+  const sample = path.resolve(__dirname, 'data', 'sample.tif')
+
+  // 2x2 tiles of 10x10 pixels of 1x1 units, the tile i is filled with i + 1
+  // the tile 4 overlaps the other tiles by 5 pixels when shifted
+  const createTiles = (shift?: number) => [ [ 0, 0 ], [ 10, 0 ], [ 0, 10 ], [ 10, 10 ] ].map(([ x, y ], i) => {
+    const ds = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Byte)
+    const s = i === 3 && shift ? shift : 0
+    ds.geoTransform = [ x - s, 1, 0, 20 - y + s, 0, -1 ]
+    ds.bands.get(1).fill(i + 1)
+    return ds.bands.get(1)
+  })
+  const window = { minX: 0, minY: 0, maxX: 20, maxY: 20 }
+
+  it('should compose the sources into one buffer', () => {
+    const data = gdal.mosaicRead(createTiles(), window, { width: 20, height: 20 })
+    assert.instanceOf(data, Uint8Array)
+    assert.lengthOf(data, 400)
+    assert.equal(data[0], 1)
+    assert.equal(data[19], 2)
+    assert.equal(data[20 * 19], 3)
+    assert.equal(data[399], 4)
+  })
+
+  it('should support a resolution and a partial coverage', () => {
+    const data = gdal.mosaicRead(createTiles(), { minX: 15, minY: 15, maxX: 25, maxY: 25 },
+      { resolution: 1, nodata: 255 })
+    assert.lengthOf(data, 100)
+    // y from 25 to 15, x from 15 to 25
+    assert.equal(data[0], 255)
+    assert.equal(data[5 * 10 + 0], 2)
+    assert.equal(data[5 * 10 + 4], 2)
+    assert.equal(data[5 * 10 + 5], 255)
+    assert.equal(data[9 * 10 + 9], 255)
+  })
+
+  it('should resample the sources', () => {
+    const data = gdal.mosaicRead(createTiles(), window, { resolution: [ 2, 4 ], data_type: gdal.GDT_Float32 })
+    assert.instanceOf(data, Float32Array)
+    assert.lengthOf(data, 10 * 5)
+    assert.equal(data[0], 1)
+    assert.equal(data[49], 4)
+  })
+
+  it('should support the order of the overlapping sources', () => {
+    const last = gdal.mosaicRead(createTiles(5), window, { width: 20, height: 20 })
+    const first = gdal.mosaicRead(createTiles(5), window, { width: 20, height: 20, order: 'first' })
+    // (7, 12) is covered by the tiles 3 and 4
+    assert.equal(last[12 * 20 + 7], 4)
+    assert.equal(first[12 * 20 + 7], 3)
+  })
+
+  it('should not cover the other sources with nodata pixels', () => {
+    const tiles = createTiles(5)
+    tiles[3].noDataValue = 4
+    const data = gdal.mosaicRead(tiles, window, { width: 20, height: 20 })
+    assert.equal(data[12 * 20 + 7], 3)
+  })
+
+  it('should be equivalent to reading the source', () => {
+    const ds = gdal.open(sample)
+    const gt = ds.geoTransform as number[]
+    const data = gdal.mosaicRead([ ds.bands.get(1) ], {
+      minX: gt[0] + 100 * gt[1],
+      maxX: gt[0] + 164 * gt[1],
+      maxY: gt[3] + 50 * gt[5],
+      minY: gt[3] + 82 * gt[5]
+    }, { width: 64, height: 32 })
+    assert.deepEqual(data, ds.bands.get(1).pixels.read(100, 50, 64, 32))
+  })
+
+  it('should skip the sources outside of the window', () => {
+    const outside = gdal.open(sample).bands.get(1)
+    const tiles = createTiles()
+    assert.deepEqual(
+      gdal.mosaicRead([ ...tiles, outside ], window, { width: 20, height: 20 }),
+      gdal.mosaicRead(tiles, window, { width: 20, height: 20 }))
+  })
+
+  it('should fill the buffer when no source intersects the window', () => {
+    const far = { minX: 1000, minY: 1000, maxX: 1010, maxY: 1010 }
+    const source = gdal.open(sample).bands.get(1)
+    assert.deepEqual([ ...gdal.mosaicRead([ source ], far, { width: 2, height: 2, nodata: 7 }) ], [ 7, 7, 7, 7 ])
+    assert.deepEqual([ ...gdal.mosaicRead([], far, { width: 2, height: 2, data_type: gdal.GDT_Byte }) ], [ 0, 0, 0, 0 ])
+  })
+
+  it('should take the default nodata value from the first source', () => {
+    const outside = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Byte)
+    outside.geoTransform = [ 1000, 1, 0, 1000, 0, -1 ]
+    outside.bands.get(1).noDataValue = 9
+    const data = gdal.mosaicRead([ outside.bands.get(1), ...createTiles() ], { minX: 15, minY: 15, maxX: 25, maxY: 25 },
+      { resolution: 1 })
+    assert.equal(data[0], 9)
+    assert.equal(data[5 * 10], 2)
+  })
+
+  it('should throw on invalid arguments', () => {
+    assert.throws(() => gdal.mosaicRead(createTiles(), window, {}), /width and height or resolution/)
+    assert.throws(() => gdal.mosaicRead(createTiles(), { minX: 1, minY: 0, maxX: 0, maxY: 1 }, { width: 1, height: 1 }),
+      /Invalid window/)
+    assert.throws(() => gdal.mosaicRead(createTiles(), window, { width: 20, height: 20, order: 'middle' }),
+      /order must be/)
+  })
+
+  it('should throw on sources in different SRS', () => {
+    const tiles = createTiles()
+    tiles[0].ds.srs = gdal.SpatialReference.fromEPSG(4326)
+    tiles[1].ds.srs = gdal.SpatialReference.fromEPSG(3857)
+    assert.throws(() => gdal.mosaicRead(tiles, window, { width: 20, height: 20 }), /same SRS/)
+  })
+})
+
+describe('gdal.mosaicReadAsync()', () => {
+  it('should compose the sources into one buffer', async () => {
+    const tiles = [ 0, 10 ].map((x) => {
+      const ds = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Int16)
+      ds.geoTransform = [ x, 1, 0, 10, 0, -1 ]
+      ds.bands.get(1).fill(x + 1)
+      return ds.bands.get(1)
+    })
+    const data = await gdal.mosaicReadAsync(tiles, { minX: 0, minY: 0, maxX: 20, maxY: 10 }, { width: 20, height: 10 })
+    assert.instanceOf(data, Int16Array)
+    assert.equal(data[0], 1)
+    assert.equal(data[10], 11)
+  })
+  it('should keep the sources alive while running', async () => {
+    const sample = path.resolve(__dirname, 'data', 'sample.tif')
+    const gt = gdal.open(sample).geoTransform as number[]
+    const window = { minX: gt[0], maxX: gt[0] + 100 * gt[1], minY: gt[3] + 100 * gt[5], maxY: gt[3] }
+    const q = gdal.mosaicReadAsync([ sample, sample ].map((f) => gdal.open(f).bands.get(1)), window,
+      { width: 100, height: 100 })
+    global.gc!()
+    const data = await q
+    assert.lengthOf(data, 100 * 100)
+  })
+})
@@ -134,6 +134,51 @@ describe('gdal.RasterBandAsync', () => {
             }))
           }))
         })
+        describe('w/withMask option', () => {
+          const create = (type: string, noData: number | null) => {
+            const ds = gdal.open('temp', 'w', 'MEM', 64, 32, 1, type)
+            const band = ds.bands.get(1)
+            if (noData !== null) band.noDataValue = noData
+            const data = new Float64Array(64 * 32)
+            for (let i = 0; i < data.length; i++) data[i] = i % 7 === 0 ? (noData ?? 0) : i % 100
+            band.pixels.write(0, 0, 64, 32, data, { data_type: gdal.GDT_Float64 })
+            return band
+          }
+
+          it('should compute the mask from the nodata value', async () => {
+            for (const [ type, noData ] of [
+              [ gdal.GDT_Byte, 0 ], [ gdal.GDT_Int16, -1 ], [ gdal.GDT_Float32, -1.5 ], [ gdal.GDT_Float64, NaN ]
+            ] as [string, number][]) {
+              const band = create(type, noData)
+              const r = await band.pixels.readAsync(3, 2, 40, 20, undefined, { withMask: true })
+              assert.instanceOf(r.mask, Uint8Array)
+              assert.lengthOf(r.data, 40 * 20)
+              assert.deepEqual(r.mask, band.getMaskBand().pixels.read(3, 2, 40, 20), type)
+              assert.include(r.mask, 0)
+            }
+          })
+          it('should read the mask band when the data is converted', async () => {
+            const band = create(gdal.GDT_Int16, 200)
+            const r = await band.pixels.readAsync(0, 0, 64, 32, undefined,
+              { withMask: true, data_type: gdal.GDT_Byte, buffer_width: 32, buffer_height: 16 })
+            assert.instanceOf(r.data, Uint8Array)
+            assert.lengthOf(r.mask, 32 * 16)
+            assert.deepEqual(r.mask,
+              band.getMaskBand().pixels.read(0, 0, 64, 32, undefined, { buffer_width: 32, buffer_height: 16 }))
+          })
+          it('should return a valid mask when there is no nodata value', async () => {
+            const band = create(gdal.GDT_Byte, null)
+            const r = await band.pixels.readAsync(0, 0, 64, 32, undefined, { withMask: true })
+            assert.isTrue(r.mask.every((v) => v === 255))
+          })
+          it('should support the alpha band and the synchronous version', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 2, gdal.GDT_Byte)
+            ds.bands.get(2).colorInterpretation = gdal.GCI_AlphaBand
+            ds.bands.get(2).pixels.write(0, 0, 16, 1, new Uint8Array(16).fill(255))
+            const r = ds.bands.get(1).pixels.read(0, 0, 16, 16, undefined, { withMask: true })
+            assert.deepEqual(r.mask, ds.bands.get(2).pixels.read(0, 0, 16, 16))
+          })
+        })
         describe('w/data argument', () => {
           it('should put the data in the existing array', () => {
             const ds = gdal.openAsync('temp',
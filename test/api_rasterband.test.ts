@@ -495,6 +495,13 @@ describe('gdal.RasterBand', () => {
           const band = ds.bands.get(1)
           assert.equal(band.noDataValue, 0)
         })
+        it('should not wait for pending async operations on read-only datasets', async () => {
+          const ds = await gdal.openAsync(`${__dirname}/data/dem_azimuth50_pa.img`)
+          const band = ds.bands.get(1)
+          const q = band.pixels.readAsync(0, 0, band.size.x, band.size.y)
+          assert.equal(band.noDataValue, 0)
+          return assert.isFulfilled(q)
+        })
         it('should return null if not set', () => {
           const ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
           const band = ds.bands.get(1)
@@ -1579,6 +1586,82 @@ describe('gdal.RasterBand', () => {
         }
       })
     })
+    describe('getCacheUsage()', () => {
+      it('should return the blocks of the band in the block cache', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        assert.deepEqual(band.getCacheUsage(), { blocks: 0, dirty: 0, bytes: 0 })
+        band.pixels.read(0, 0, 984, 16)
+        assert.deepEqual(band.getCacheUsage(), { blocks: 2, dirty: 0, bytes: 2 * 984 * 8 })
+        ds.flush()
+        assert.deepEqual(band.getCacheUsage(), { blocks: 0, dirty: 0, bytes: 0 })
+      })
+    })
+    describe('getCacheUsageAsync()', () => {
+      it('should return the blocks of the band in the block cache', async () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        await band.pixels.readAsync(0, 0, 984, 8)
+        return assert.eventually.deepEqual(band.getCacheUsageAsync(), { blocks: 1, dirty: 0, bytes: 984 * 8 })
+      })
+    })
+    describe('getDataCoverage()', () => {
+      const file = '/vsimem/sparse_coverage.tif'
+      before(() => {
+        const ds = gdal.open(file, 'w', 'GTiff', 64, 64, 1, gdal.GDT_Byte, [ 'SPARSE_OK=TRUE', 'BLOCKYSIZE=16' ])
+        ds.bands.get(1).pixels.write(0, 16, 64, 16, new Uint8Array(64 * 16).fill(1))
+        ds.close()
+      })
+      after(() => gdal.vsimem.release(file))
+      it('should report the empty regions', () => {
+        const band = gdal.open(file).bands.get(1)
+        assert.deepInclude(band.getDataCoverage(0, 32, 64, 32), { data: false, empty: true, percent: 0 })
+        assert.deepInclude(band.getDataCoverage(0, 16, 64, 16), { data: true, empty: false, percent: 100 })
+        assert.include(band.getDataCoverage(), { data: true, empty: true, percent: 25 })
+      })
+      it('should report a driver without data coverage as data', () => {
+        const band = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte).bands.get(1)
+        assert.include(band.getDataCoverage(), { data: true, empty: false })
+      })
+      it('should throw on an invalid window', () => {
+        const band = gdal.open(file).bands.get(1)
+        assert.throws(() => band.getDataCoverage(32, 32, 64, 64), /Invalid window/)
+      })
+    })
+    describe('getDataCoverageAsync()', () => {
+      it('should report the data coverage', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        return assert.eventually.include(ds.bands.get(1).getDataCoverageAsync(0, 0, 16, 16), { data: true })
+      })
+    })
+    describe('adviseRead()', () => {
+      it('should accept a window', () => {
+        const band = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1)
+        band.adviseRead(0, 0, 984, 64)
+        band.adviseRead(0, 0, 984, 64, { buffer_width: 492, buffer_height: 32, data_type: gdal.GDT_Float32 })
+      })
+      it('should throw on an invalid data type', () => {
+        const band = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1)
+        assert.throws(() => band.adviseRead(0, 0, 984, 64, { data_type: 'Float42' }), /Invalid GDAL data type/)
+      })
+      it('should throw on an invalid window', () => {
+        const band = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1)
+        assert.throws(() => band.adviseRead(0, 0, 0, 64), /Invalid window/)
+        assert.throws(() => band.adviseRead(-1, 0, 984, 64), /Invalid window/)
+        assert.throws(() => band.adviseRead(0, 800, 984, 64), /Invalid window/)
+        assert.throws(() => band.adviseRead(0, 0, 984, 64, { buffer_width: 0 }), /Invalid buffer size/)
+      })
+    })
+    describe('adviseReadAsync()', () => {
+      it('should accept a window', () => {
+        const band = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1)
+        return assert.isFulfilled(band.adviseReadAsync(0, 0, 984, 64))
+      })
+      it('should reject an invalid window', () => {
+        const band = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1)
+        return assert.isRejected(band.adviseReadAsync(1, 0, 984, 64), /Invalid window/)
+      })
+    })
     describe('"overviews" property', () => {
       describe('getter', () => {
         it('should return overview collection', () => {
@@ -83,6 +83,56 @@ describe('gdal.RasterReadStream', () => {
   for (const file of inputFiles) {
     it(`should accept various formats (${file})`, (done) => readTest(done, file, true))
   }
+  it('should announce the next blocks w/prefetch', async () => {
+    const ds = gdal.open(path.resolve(__dirname, 'data', 'sample.tif'))
+    const band = ds.bands.get(1)
+    const advised: number[][] = []
+    const adviseReadAsync = band.adviseReadAsync
+    band.adviseReadAsync = function (...args: Parameters<typeof adviseReadAsync>) {
+      advised.push(args.slice(0, 4) as number[])
+      return adviseReadAsync.apply(this, args)
+    }
+    const rs = band.pixels.createReadStream({ prefetch: 2 })
+    for await (const chunk of rs) assert.instanceOf(chunk, Uint8Array)
+    assert.deepEqual(advised[0], [ 0, 0, band.size.x, 3 * band.blockSize.y ])
+    for (let i = 1; i < advised.length; i++) {
+      assert.equal(advised[i][1], advised[i - 1][1] + advised[i - 1][3])
+    }
+    const last = advised[advised.length - 1]
+    assert.equal(last[1] + last[3], band.size.y)
+  })
+  for (const prefetch of [ 0, undefined ]) {
+    it(`should not announce anything w/prefetch = ${prefetch}`, async () => {
+      const band = gdal.open(path.resolve(__dirname, 'data', 'sample.tif')).bands.get(1)
+      band.adviseReadAsync = () => {
+        throw new Error('adviseReadAsync called')
+      }
+      const rs = band.pixels.createReadStream({ prefetch })
+      for await (const chunk of rs) assert.instanceOf(chunk, Uint8Array)
+    })
+  }
+  for (const blockOptimize of [ true, false ]) {
+    it(`should skip the empty regions w/skipEmpty${blockOptimize ? '' : ' w/o blockOptimize'}`, async () => {
+      const file = '/vsimem/sparse_stream.tif'
+      const ds = gdal.open(file, 'w', 'GTiff', 64, 64, 1, gdal.GDT_Byte, [ 'SPARSE_OK=TRUE', 'BLOCKYSIZE=16' ])
+      ds.bands.get(1).pixels.write(0, 16, 64, 16, new Uint8Array(64 * 16).fill(1))
+      ds.close()
+
+      const rs = gdal.open(file).bands.get(1).pixels.createReadStream({ skipEmpty: true, blockOptimize })
+      let empty = 0, data = 0
+      for await (const chunk of rs) {
+        if (chunk.empty !== undefined) {
+          empty += chunk.empty
+        } else {
+          assert.isTrue(chunk.every((v: number) => v === 1))
+          data += chunk.length
+        }
+      }
+      assert.equal(empty, 3 * 16 * 64)
+      assert.equal(data, 16 * 64)
+      gdal.vsimem.release(file)
+    })
+  }
 })
 
 describe('gdal.RasterWriteStream', () => {
@@ -327,4 +377,11 @@ describe('gdal.RasterMuxStream', () => {
 
   it('should accept multiple inputs', () => testMux(undefined))
   it('should support different block sizes', () => testMux(false))
+  it('should reject inputs created w/skipEmpty', () => {
+    const band = gdal.open(path.resolve(__dirname, 'data', 'AROME_T2m_10.tiff')).bands.get(1)
+    assert.throws(() => new gdal.RasterMuxStream({
+      T2m: band.pixels.createReadStream(),
+      sparse: band.pixels.createReadStream({ skipEmpty: true })
+    }), /skipEmpty/)
+  })
 })
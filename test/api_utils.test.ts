@@ -2,6 +2,9 @@ import * as gdal from 'gdal-async'
 import { assert } from 'chai'
 import * as path from 'path'
 import * as semver from 'semver'
+import * as http from 'http'
+import { AddressInfo } from 'net'
+import { Writable } from 'stream'
 
 describe('gdal_utils', () => {
   afterEach(() => void global.gc!())
@@ -811,4 +814,100 @@ describe('gdal_utils', () => {
       gdal.vsimem.release(tempFile)
     })
   })
+
+  describe('createCOGAsync', () => {
+    before(function () {
+      if (!semver.gte(gdal.version, '3.1.0')) {
+        this.skip()
+      }
+    })
+
+    it('should produce a Cloud-Optimized GeoTIFF', async () => {
+      const src = await gdal.openAsync(path.resolve(__dirname, 'data', 'sample.tif'))
+      const tmpFile = `/vsimem/${String(Math.random()).substring(2)}.tif`
+      let calls = 0
+      await gdal.createCOGAsync(src, tmpFile, {
+        compress: 'DEFLATE',
+        blockSize: 256,
+        threads: 2,
+        progress_cb: () => calls++
+      })
+      assert.isAbove(calls, 0)
+
+      const cog = await gdal.openAsync(tmpFile)
+      assert.strictEqual(cog.driver.description, 'GTiff')
+      assert.strictEqual(cog.getMetadata('IMAGE_STRUCTURE').LAYOUT, 'COG')
+      assert.strictEqual(cog.getMetadata('IMAGE_STRUCTURE').COMPRESSION, 'DEFLATE')
+      assert.deepEqual(cog.bands.get(1).blockSize, { x: 256, y: 256 })
+      assert.isAbove(cog.bands.get(1).overviews.count(), 0)
+      assert.strictEqual(gdal.checksumImage(cog.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+      cog.close()
+      gdal.vsimem.release(tmpFile)
+    })
+
+    it('should support writing to a stream', async () => {
+      const src = await gdal.openAsync(path.resolve(__dirname, 'data', 'sample.tif'))
+      const chunks: Buffer[] = []
+      const output = new Writable({
+        highWaterMark: 1024,
+        write: (chunk, _encoding, cb) => {
+          chunks.push(chunk)
+          setImmediate(cb)
+        }
+      })
+      await gdal.createCOGAsync(src, output)
+      assert.isTrue(output.writableFinished)
+
+      const tmpFile = `/vsimem/${String(Math.random()).substring(2)}.tif`
+      gdal.vsimem.set(Buffer.concat(chunks), tmpFile)
+      const cog = gdal.open(tmpFile)
+      assert.strictEqual(cog.getMetadata('IMAGE_STRUCTURE').LAYOUT, 'COG')
+      assert.strictEqual(gdal.checksumImage(cog.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+      cog.close()
+      gdal.vsimem.release(tmpFile)
+    })
+
+    it('should support writing to an HTTP response', async () => {
+      const src = await gdal.openAsync(path.resolve(__dirname, 'data', 'sample.tif'))
+      const server = http.createServer((_req, res) => {
+        gdal.createCOGAsync(src, res).catch(() => undefined)
+      })
+      await new Promise<void>((resolve) => server.listen(0, '127.0.0.1', resolve))
+      try {
+        const port = (server.address() as AddressInfo).port
+        const body = await new Promise<Buffer>((resolve, reject) => {
+          http.get(`http://127.0.0.1:${port}/`, (res) => {
+            const chunks: Buffer[] = []
+            res.on('data', (chunk) => chunks.push(chunk))
+            res.on('end', () => resolve(Buffer.concat(chunks)))
+            res.on('error', reject)
+          }).on('error', reject)
+        })
+
+        const tmpFile = `/vsimem/${String(Math.random()).substring(2)}.tif`
+        gdal.vsimem.set(body, tmpFile)
+        const cog = gdal.open(tmpFile)
+        assert.strictEqual(cog.getMetadata('IMAGE_STRUCTURE').LAYOUT, 'COG')
+        assert.strictEqual(gdal.checksumImage(cog.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+        cog.close()
+        gdal.vsimem.release(tmpFile)
+      } finally {
+        server.close()
+      }
+    })
+
+
+      const src = await gdal.openAsync(path.resolve(__dirname, 'data', 'sample.tif'))
+      src.close()
+      const output = new Writable({ write: (_chunk, _encoding, cb) => cb() })
+      await assert.isRejected(gdal.createCOGAsync(src, output), /already been destroyed/)
+      assert.isTrue(output.destroyed)
+    })
+
+    it('should reject on invalid arguments', () => Promise.all([
+      assert.isRejected(gdal.createCOGAsync({} as gdal.Dataset, '/vsimem/invalid.tif'), /instance of gdal.Dataset/),
+      assert.isRejected(gdal.createCOGAsync(gdal.open(path.resolve(__dirname, 'data', 'sample.tif')),
+        {} as string), /filename or a Writable/)
+    ]))
+  })
 })